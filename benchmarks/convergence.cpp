@@ -0,0 +1,172 @@
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <tuple>
+//
+#include <lyrahgames/pareto/pareto.hpp>
+//
+#include <lyrahgames/pareto/gallery/gallery.hpp>
+
+using namespace std;
+using namespace lyrahgames;
+using namespace lyrahgames::pareto;
+
+using real = double;
+
+// Every optimizer uses a population of about 100 samples such that all of
+// them are able to converge within the default evaluation budget.
+const auto optimizers = make_tuple(
+    pair{"naive",
+         [](auto problem, auto&) { return naive::optimizer{problem}; }},
+    pair{"naive-sobol",
+         [](auto problem, auto&) {
+           return naive::optimizer{problem, sampling::sobol};
+         }},
+    pair{"nsga2",
+         [](auto problem, auto& rng) {
+           return nsga2::optimizer{problem, rng, {.population = 100}};
+         }},
+    pair{"nsga3",
+         [](auto problem, auto& rng) {
+           // The reference points must not outnumber the population.
+           const auto m = problem.objective_count();
+           return nsga3::optimizer{
+               problem,
+               rng,
+               {.population = 100, .divisions = simplex_divisions(m, 100)}};
+         }},
+    pair{"moead",
+         [](auto problem, auto& rng) {
+           return moead::optimizer{problem, rng, {.population = 100}};
+         }},
+    pair{"sms-emoa",
+         [](auto problem, auto& rng) {
+           return sms_emoa::optimizer{problem, rng, {.population = 100}};
+         }},
+    pair{"island",
+         [](auto problem, auto& rng) {
+           return island::optimizer{
+               problem, rng, {.islands = 4, .population = 25}};
+         }},
+    pair{"async-nsga2", [](auto problem, auto& rng) {
+           return async_nsga2::optimizer{problem, rng, {.population = 100}};
+         }});
+
+// Only problems of the gallery with a known Pareto frontier are usable.
+// Scalable problems use three objectives and their default parameter counts.
+const auto problems =
+    make_tuple(pair{"zdt1", gallery::zdt1<real>},
+               pair{"zdt2", gallery::zdt2<real>},
+               pair{"zdt3", gallery::zdt3<real>},
+               pair{"zdt4", gallery::zdt4<real>},
+               pair{"zdt6", gallery::zdt6<real>},
+               pair{"fonseca-fleming", gallery::fonseca_fleming<real>{}},
+               pair{"schaffer1", gallery::schaffer1<real>{10}},
+               pair{"schaffer2", gallery::schaffer2<real>},
+               pair{"dtlz1", gallery::dtlz1<real, 3>{}},
+               pair{"dtlz2", gallery::dtlz2<real, 3>{}},
+               pair{"dtlz3", gallery::dtlz3<real, 3>{}},
+               pair{"dtlz4", gallery::dtlz4<real, 3>{}},
+               pair{"dtlz5", gallery::dtlz5<real, 3>{}},
+               pair{"dtlz6", gallery::dtlz6<real, 3>{}},
+               pair{"dtlz7", gallery::dtlz7<real, 3>{}},
+               pair{"wfg1", gallery::wfg1<real, 3>{}},
+               pair{"wfg2", gallery::wfg2<real, 3>{}},
+               pair{"wfg3", gallery::wfg3<real, 3>{}},
+               pair{"wfg4", gallery::wfg4<real, 3>{}},
+               pair{"wfg5", gallery::wfg5<real, 3>{}},
+               pair{"wfg6", gallery::wfg6<real, 3>{}},
+               pair{"wfg7", gallery::wfg7<real, 3>{}},
+               pair{"wfg8", gallery::wfg8<real, 3>{}},
+               pair{"wfg9", gallery::wfg9<real, 3>{}},
+               pair{"lsmop1", gallery::lsmop1<real, 3>{}},
+               pair{"lsmop2", gallery::lsmop2<real, 3>{}},
+               pair{"lsmop3", gallery::lsmop3<real, 3>{}},
+               pair{"lsmop4", gallery::lsmop4<real, 3>{}},
+               pair{"lsmop5", gallery::lsmop5<real, 3>{}},
+               pair{"lsmop6", gallery::lsmop6<real, 3>{}},
+               pair{"lsmop7", gallery::lsmop7<real, 3>{}},
+               pair{"lsmop8", gallery::lsmop8<real, 3>{}},
+               pair{"lsmop9", gallery::lsmop9<real, 3>{}});
+
+void for_each(const auto& tuple, auto&& f) {
+  apply([&](const auto&... x) { (f(x), ...); }, tuple);
+}
+
+void usage(const char* program) {
+  cerr << "usage: " << program
+       << " [--seeds <count>] [--evaluations <count>]"
+          " [--checkpoints <count>] [--problem <name>] [--optimizer <name>]\n"
+          "Writes the convergence of all optimizers on all gallery problems"
+          " with known Pareto frontier as CSV to the standard output.\n";
+}
+
+int main(int argc, char* argv[]) {
+  size_t seeds = 5;
+  size_t evaluations = 20000;
+  size_t checkpoints = 20;
+  string_view problem_filter{};
+  string_view optimizer_filter{};
+
+  for (int i = 1; i < argc; ++i) {
+    const string_view option = argv[i];
+    if (option == "--help") {
+      usage(argv[0]);
+      return 0;
+    }
+    if (i + 1 == argc) {
+      usage(argv[0]);
+      return 1;
+    }
+    const string_view value = argv[++i];
+    if (option == "--seeds")
+      seeds = stoull(string(value));
+    else if (option == "--evaluations")
+      evaluations = stoull(string(value));
+    else if (option == "--checkpoints")
+      checkpoints = stoull(string(value));
+    else if (option == "--problem")
+      problem_filter = value;
+    else if (option == "--optimizer")
+      optimizer_filter = value;
+    else {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+
+  if (!perf_counters{}.available())
+    cerr << "Hardware performance counters are not available and stay zero.\n";
+
+  cout << "problem,optimizer,seed,evaluations,cpu_seconds,wall_seconds,"
+          "cycles,instructions,cache_misses,branch_misses,hypervolume_ratio,"
+          "igd,igd_plus,front_size\n"
+       << setprecision(9);
+
+  for_each(problems, [&](const auto& p) {
+    const auto& [problem_name, problem] = p;
+    if (!problem_filter.empty() && problem_filter != problem_name) return;
+    const benchmark::reference<real> reference{problem, 10000};
+    for_each(optimizers, [&](const auto& o) {
+      const auto& [optimizer_name, make] = o;
+      if (!optimizer_filter.empty() && optimizer_filter != optimizer_name)
+        return;
+      for (size_t seed = 0; seed < seeds; ++seed) {
+        mt19937 rng{mt19937::result_type(seed)};
+        const auto results = benchmark::convergence(
+            problem, reference, rng, make, evaluations, checkpoints);
+        for (const auto& r : results)
+          cout << problem_name << ',' << optimizer_name << ',' << seed << ','
+               << r.evaluations << ',' << r.cpu_seconds << ','
+               << r.wall_seconds << ',' << r.counters.cycles << ','
+               << r.counters.instructions << ',' << r.counters.cache_misses
+               << ',' << r.counters.branch_misses << ','
+               << r.hypervolume_ratio << ',' << r.igd << ',' << r.igd_plus
+               << ',' << r.front_size << '\n';
+      }
+    });
+  });
+}
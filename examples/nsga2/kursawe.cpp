@@ -10,6 +10,7 @@
 //
 #include <lyrahgames/pareto/frontier.hpp>
 #include <lyrahgames/pareto/nsga2.hpp>
+#include <lyrahgames/pareto/observer.hpp>
 //
 #include <lyrahgames/pareto/gallery/kursawe.hpp>
 
@@ -32,7 +33,22 @@ int main() {
   nsga2::optimizer optimizer(
       problem, rng,
       {.population = 1000, .kill_ratio = 0.2, .crossover_ratio = 0.9});
-  optimizer.optimize(rng, 1000);
+  // Accumulate the time and hardware counters of every phase.
+  generation_statistics::timings phases{};
+  generation_statistics::counts counters{};
+  optimizer.optimize(
+      rng, 1000, with_counters([&](const generation_statistics& statistics) {
+        const auto& t = statistics.seconds;
+        phases.populate += t.populate;
+        phases.evaluation += t.evaluation;
+        phases.non_dominated_sort += t.non_dominated_sort;
+        phases.crowding_distance_sort += t.crowding_distance_sort;
+        const auto& c = statistics.counters;
+        counters.populate += c.populate;
+        counters.evaluation += c.evaluation;
+        counters.non_dominated_sort += c.non_dominated_sort;
+        counters.crowding_distance_sort += c.crowding_distance_sort;
+      }));
 
   // Cast the estimated Pareto frontier to a usable output format.
   const auto pareto_front = frontier_cast<frontier<real>>(optimizer);
@@ -40,6 +56,17 @@ int main() {
   const auto end = clock::now();
   const auto time = chrono::duration<double>(end - start).count();
   cout << setw(20) << "time = " << setw(20) << time << " s\n";
+  cout << setw(20) << "populate = " << setw(20) << phases.populate << " s\n";
+  cout << setw(20) << "evaluation = " << setw(20) << phases.evaluation
+       << " s\n";
+  cout << setw(20) << "sorting = " << setw(20) << phases.non_dominated_sort
+       << " s\n";
+  cout << setw(20) << "crowding = " << setw(20)
+       << phases.crowding_distance_sort << " s\n";
+  cout << setw(20) << "sorting IPC = " << setw(20)
+       << counters.non_dominated_sort.instructions_per_cycle() << '\n';
+  cout << setw(20) << "sorting misses = " << setw(20)
+       << counters.non_dominated_sort.cache_misses << '\n';
 
 // Plot the data.
 #include "../kursawe_plot.ipp"
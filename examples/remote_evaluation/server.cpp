@@ -0,0 +1,21 @@
+#include <iostream>
+#include <string>
+//
+#include <lyrahgames/pareto/remote_evaluator.hpp>
+//
+#include <lyrahgames/pareto/gallery/zitzler_deb_thiele.hpp>
+
+using namespace std;
+using namespace lyrahgames;
+using namespace lyrahgames::pareto;
+
+using real = float;
+
+// Serves evaluations of the ZDT3 problem on the given address which is either
+// given by 'unix:<path>' or '<host>:<port>'.
+int main(int argc, char* argv[]) {
+  const string address = (argc > 1) ? argv[1] : "127.0.0.1:5555";
+  remote_server server{gallery::zdt3<real>, address, {.threads = 4}};
+  cout << "serving on " << server.address() << endl;
+  server.serve();
+}
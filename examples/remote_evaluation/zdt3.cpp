@@ -0,0 +1,43 @@
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+//
+#include <lyrahgames/gnuplot/gnuplot.hpp>
+//
+#include <lyrahgames/pareto/frontier.hpp>
+#include <lyrahgames/pareto/nsga2.hpp>
+#include <lyrahgames/pareto/remote_evaluator.hpp>
+//
+#include <lyrahgames/pareto/gallery/zitzler_deb_thiele.hpp>
+
+using namespace std;
+using namespace lyrahgames;
+using namespace lyrahgames::pareto;
+
+using real = float;
+
+// Estimates the Pareto frontier of the ZDT3 problem evaluated by the server
+// example running on the given address.
+int main(int argc, char* argv[]) {
+  const string address = (argc > 1) ? argv[1] : "127.0.0.1:5555";
+  mt19937 rng{random_device{}()};
+
+  using clock = chrono::high_resolution_clock;
+  const auto start = clock::now();
+
+  // The local problem instance only provides counts and box constraints.
+  const auto problem = remote_evaluator{gallery::zdt3<real>, address,
+                                        {.batch = 64, .pipeline = 8}};
+
+  // Estimate the Pareto frontier and cast it to a usable output format.
+  const auto pareto_front = nsga2::optimization<frontier<real>>(problem, rng);
+
+  const auto end = clock::now();
+  const auto time = chrono::duration<double>(end - start).count();
+  cout << setw(20) << "time = " << setw(20) << time << " s\n";
+
+// Plot the data.
+#include "../zdt3_plot.ipp"
+}
@@ -0,0 +1,298 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <random>
+#include <span>
+#include <vector>
+//
+#include <lyrahgames/pareto/frontier_cast.hpp>
+#include <lyrahgames/pareto/meta.hpp>
+#include <lyrahgames/pareto/parallel.hpp>
+#include <lyrahgames/pareto/ranked_population.hpp>
+#include <lyrahgames/pareto/tracing.hpp>
+#include <lyrahgames/pareto/variation.hpp>
+
+namespace lyrahgames::pareto {
+
+namespace async_nsga2 {
+
+/// Specialized Pareto Problems for the Asynchronous NSGA2 Algorithm
+template <typename T>
+concept problem = generic::evaluatable_problem<T,
+                                               std::span<typename T::real>,
+                                               std::span<typename T::real>>;
+
+/// Asynchronous Steady-State NSGA2 Optimization Algorithm
+/// Every worker thread repeatedly generates one offspring, evaluates it
+/// without holding any lock, and inserts it into the population. The
+/// population is kept sorted into domination layers incrementally and the
+/// point of the worst layer with the smallest crowding distance is discarded
+/// after every insertion. There are no generation barriers. Hence, workers
+/// never wait for slow evaluations of other workers and stay busy even if
+/// evaluation times vary strongly. For more than one thread, the problem's
+/// 'evaluate' function has to be thread-safe.
+template <problem T>
+class optimizer {
+ public:
+  using problem_type = T;
+  using real = typename problem_type::real;
+
+  /// Structure to provide easy intialization of the parameters of the
+  /// algorithm. By using designated initializers, named function arguments can
+  /// be simulated. The iterations are given by the number of evaluations.
+  struct configuration {
+    size_t iterations = 100000;
+    size_t population = 100;
+    float crossover_ratio = 0.3;
+    size_t threads = default_thread_count();
+  };
+
+  optimizer() = default;
+  explicit optimizer(problem_type p,
+                     generic::random_number_generator auto&& rng,
+                     configuration config = {})
+      : problem(p),
+        s(std::max<size_t>(2, config.population)),
+        iter(config.iterations),
+        crossover_probability(config.crossover_ratio),
+        threads(std::max<size_t>(1, config.threads)) {
+    init();
+    init_population(std::forward<decltype(rng)>(rng));
+  }
+
+  void init() {
+    const auto n = problem.parameter_count();
+    const auto m = problem.objective_count();
+    // Every thread needs one additional slot for its offspring in flight.
+    const auto slots = s + threads;
+    parameters.resize(n * slots);
+    objectives.resize(m * slots);
+    ranks.resize(slots);
+    alive.reserve(slots);
+    position.resize(slots);
+    scratch.resize(n);
+  }
+
+  /// Clamp the parameters referenced by the given index to the box constraints
+  /// defined by the current problem.
+  void clamp(size_t index) {
+    using std::clamp;
+    const auto n = problem.parameter_count();
+    for (size_t i = 0; i < n; ++i)
+      parameters[n * index + i] = clamp(parameters[n * index + i],
+                                        problem.box_min(i), problem.box_max(i));
+  }
+
+  /// Evaluate all objectives at the given index by using the parameters
+  /// referenced by the given index.
+  void evaluate(size_t index) {
+    using std::span;
+    const auto n = problem.parameter_count();
+    const auto m = problem.objective_count();
+    problem.evaluate(
+        span{&parameters[n * index], &parameters[n * (index + 1)]},
+        span{&objectives[m * index], &objectives[m * (index + 1)]});
+  }
+
+  /// Generates a random population to start with the optimization algorithm.
+  /// The initial individuals are evaluated concurrently.
+  void init_population(generic::random_number_generator auto&& rng) {
+    using namespace std;
+    const auto n = problem.parameter_count();
+    const auto m = problem.objective_count();
+
+    uniform_real_distribution<real> distribution{0, 1};
+    const auto random = [&] { return distribution(rng); };
+
+    for (size_t i = 0; i < s; ++i)
+      for (size_t j = 0; j < n; ++j)
+        parameters[n * i + j] =
+            lerp(problem.box_min(j), problem.box_max(j), random());
+    parallel_for(
+        s,
+        [&](size_t, size_t first, size_t last) {
+          for (size_t i = first; i < last; ++i)
+            evaluate(i);
+        },
+        threads, 1);
+
+    alive.clear();
+    for (size_t i = 0; i < s; ++i) {
+      ranks.insert(objectives.data(), m, i);
+      position[i] = alive.size();
+      alive.push_back(i);
+    }
+    free.clear();
+    for (auto i = parameters.size() / n; i > s; --i)
+      free.push_back(i - 1);
+  }
+
+  /// Takes a free slot and fills it with the parameters of a new offspring
+  /// generated from random individuals of the current population. Returns the
+  /// index of the slot.
+  size_t generate(generic::random_number_generator auto&& rng) {
+    LYRAHGAMES_PARETO_TRACE_SCOPE("async_nsga2::generate");
+    using namespace std;
+    const auto n = problem.parameter_count();
+
+    uniform_int_distribution<size_t> distribution{0, alive.size() - 1};
+    const auto random = [&] { return alive[distribution(rng)]; };
+
+    const auto offspring = free.back();
+    free.pop_back();
+    if (bernoulli_distribution{crossover_probability}(rng)) {
+      // The second offspring of the crossover is discarded.
+      simulated_binary_crossover(n, &parameters[n * random()],
+                                 &parameters[n * random()],
+                                 &parameters[n * offspring], scratch.data(),
+                                 rng);
+    } else {
+      alternate_random_mutation(problem, &parameters[n * random()],
+                                &parameters[n * offspring], rng);
+    }
+    clamp(offspring);
+    return offspring;
+  }
+
+  /// Inserts the evaluated offspring of the given slot into the population
+  /// and discards the point of the worst layer with the smallest crowding
+  /// distance. The slot of the discarded point becomes free.
+  void complete(size_t offspring) {
+    LYRAHGAMES_PARETO_TRACE_SCOPE("async_nsga2::complete");
+    const auto m = problem.objective_count();
+    position[offspring] = alive.size();
+    alive.push_back(offspring);
+    ranks.insert(objectives.data(), m, offspring);
+
+    const auto index = ranks.remove_least_crowded(objectives.data(), m);
+    alive[position[index]] = alive.back();
+    position[alive.back()] = position[index];
+    alive.pop_back();
+    free.push_back(index);
+  }
+
+  /// Generates, evaluates, and inserts the given number of offspring. All
+  /// threads share the random number generator which is only accessed while
+  /// holding the lock of the population.
+  void optimize(generic::random_number_generator auto&& rng,
+                size_t iterations) {
+    using namespace std;
+
+    if (threads == 1) {
+      for (size_t i = 0; i < iterations; ++i) {
+        const auto offspring = generate(rng);
+        evaluate(offspring);
+        complete(offspring);
+      }
+      return;
+    }
+
+    mutex population_mutex{};
+    size_t dispatched = 0;
+    bool failed = false;
+    parallel_for(
+        threads,
+        [&](size_t, size_t, size_t) {
+          unique_lock lock{population_mutex};
+          while (!failed && dispatched < iterations) {
+            ++dispatched;
+            const auto offspring = generate(rng);
+            lock.unlock();
+            try {
+              LYRAHGAMES_PARETO_TRACE_SCOPE("async_nsga2::evaluate");
+              evaluate(offspring);
+            } catch (...) {
+              lock.lock();
+              failed = true;
+              free.push_back(offspring);
+              throw;
+            }
+            {
+              // Time spent waiting for other threads
+              LYRAHGAMES_PARETO_TRACE_SCOPE("async_nsga2::lock");
+              lock.lock();
+            }
+            complete(offspring);
+          }
+        },
+        threads, 1);
+  }
+
+  /// Uses the iterations count given by construction.
+  void optimize(generic::random_number_generator auto&& rng) {
+    optimize(std::forward<decltype(rng)>(rng), iter);
+  }
+
+  /// Casts the estimated Pareto points stored as an implementation detail into
+  /// a usable frontier data structure.
+  template <generic::frontier frontier_type>
+  auto frontier_cast() const {
+    using namespace std;
+    const auto n = problem.parameter_count();
+    const auto m = problem.objective_count();
+    const auto& pareto = ranks.front(0);
+    frontier_type frontier{pareto.size(), n, m};
+    for (size_t i = 0; i < pareto.size(); ++i) {
+      const auto index = pareto[i];
+      {
+        auto it = frontier.parameters_iterator(i);
+        for (size_t j = 0; j < n; ++j, ++it)
+          *it = parameters[n * index + j];
+      }
+      {
+        auto it = frontier.objectives_iterator(i);
+        for (size_t j = 0; j < m; ++j, ++it)
+          *it = objectives[m * index + j];
+      }
+    }
+    return frontier;
+  }
+
+ private:
+  problem_type problem{};
+
+  std::vector<real> parameters{};
+  std::vector<real> objectives{};
+  ranked_population<real> ranks{};
+  /// Slots of the current population and their position in this array
+  std::vector<size_t> alive{};
+  std::vector<size_t> position{};
+  /// Slots neither in the population nor in flight
+  std::vector<size_t> free{};
+  std::vector<real> scratch{};
+
+  /// Population Size
+  size_t s;
+  /// Number of evaluations given by initialization.
+  size_t iter;
+  /// Crossover/Mutation Ratio per Offspring
+  float crossover_probability;
+  size_t threads;
+};
+
+/// Short-hand function to set the parameters and optimize in one step. This
+/// function returns an instance to the asynchronous NSGA2 optimizer.
+auto optimization(
+    problem auto problem,
+    generic::random_number_generator auto&& rng,
+    typename optimizer<decltype(problem)>::configuration config = {}) {
+  optimizer result(problem, rng, config);
+  result.optimize(std::forward<decltype(rng)>(rng));
+  return result;
+}
+
+/// Short-hand function overload to additionally make a frontier cast after
+/// optimization and discard the optimizer instance in one step.
+template <generic::frontier frontier_type>
+auto optimization(
+    problem auto problem,
+    generic::random_number_generator auto&& rng,
+    typename optimizer<decltype(problem)>::configuration config = {}) {
+  return frontier_cast<frontier_type>(
+      optimization(problem, std::forward<decltype(rng)>(rng), config));
+}
+
+}  // namespace async_nsga2
+
+}  // namespace lyrahgames::pareto
@@ -0,0 +1,47 @@
+#pragma once
+#include <algorithm>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <vector>
+//
+#include <lyrahgames/pareto/evaluation_scheduler.hpp>
+#include <lyrahgames/pareto/parallel.hpp>
+
+namespace lyrahgames::pareto {
+
+/// Executes 'count' independent jobs concurrently on one shared work-stealing
+/// pool of threads. Every thread owns one object of 'state_type' that is
+/// reused for all of its jobs to avoid repeated allocations. 'run(state,
+/// index)' executes the job with the given index and returns its result.
+/// 'sink(index, result)' is called for every result in completion order.
+/// Calls to 'sink' are serialized such that it does not need to be
+/// thread-safe, but it should return quickly. 'costs' optionally estimates
+/// the relative cost of every job such that long jobs are started first. The
+/// first exception thrown by 'run' or 'sink' is rethrown after all threads
+/// have stopped.
+template <typename state_type>
+void run_batch(size_t count,
+               auto&& run,
+               auto&& sink,
+               std::span<const double> costs = {},
+               size_t threads = default_thread_count()) {
+  using namespace std;
+  threads = clamp<size_t>(threads, 1, max<size_t>(1, count));
+
+  // Jobs are much more expensive than taking them from a queue. Hence, every
+  // thread takes one job at a time and costs only determine the order.
+  evaluation_scheduler scheduler{{.threads = threads, .grain = 0}};
+  vector<state_type> states(threads);
+  mutex sink_mutex{};
+  scheduler.run(
+      count,
+      [&](size_t thread, size_t index) {
+        auto result = run(states[thread], index);
+        scoped_lock lock{sink_mutex};
+        sink(index, std::move(result));
+      },
+      costs);
+}
+
+}  // namespace lyrahgames::pareto
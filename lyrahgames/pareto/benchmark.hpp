@@ -0,0 +1,195 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <limits>
+#include <memory>
+#include <span>
+#include <vector>
+//
+#include <lyrahgames/pareto/frontier.hpp>
+#include <lyrahgames/pareto/hypervolume.hpp>
+#include <lyrahgames/pareto/meta.hpp>
+#include <lyrahgames/pareto/metrics.hpp>
+#include <lyrahgames/pareto/perf_counters.hpp>
+//
+#include <lyrahgames/pareto/gallery/pareto_frontier.hpp>
+
+namespace lyrahgames::pareto::benchmark {
+
+/// Problem wrapper that counts the evaluations of the wrapped problem. Copies
+/// share the counter such that optimizers copying the problem, like the
+/// island model, and parallel evaluations are counted as well.
+template <generic::problem T>
+class counted_problem {
+ public:
+  using problem_type = T;
+  using real = typename problem_type::real;
+
+  counted_problem() = default;
+  explicit counted_problem(problem_type p) : problem(p) {}
+
+  size_t parameter_count() const { return problem.parameter_count(); }
+  size_t objective_count() const { return problem.objective_count(); }
+  real box_min(size_t i) const { return problem.box_min(i); }
+  real box_max(size_t i) const { return problem.box_max(i); }
+
+  void evaluate(const generic::range<real> auto& x,
+                generic::range<real> auto&& y) {
+    counter->fetch_add(1, std::memory_order_relaxed);
+    problem.evaluate(x, std::forward<decltype(y)>(y));
+  }
+
+  void evaluate_batch(std::span<const real> x, std::span<real> y) requires
+      generic::batch_evaluatable_problem<problem_type> {
+    counter->fetch_add(x.size() / parameter_count(),
+                       std::memory_order_relaxed);
+    problem.evaluate_batch(x, y);
+  }
+
+  /// Returns the number of evaluations of all copies.
+  size_t evaluations() const noexcept {
+    return counter->load(std::memory_order_relaxed);
+  }
+
+ private:
+  problem_type problem{};
+  std::shared_ptr<std::atomic<size_t>> counter =
+      std::make_shared<std::atomic<size_t>>(0);
+};
+
+/// Sampled known Pareto frontier of a problem together with the reference
+/// point and the hypervolume of the frontier itself. The reference point lies
+/// ten percent of the frontier's extent beyond its nadir point such that the
+/// boundary points contribute to the hypervolume.
+template <generic::real real>
+struct reference {
+  reference() = default;
+  reference(gallery::known_frontier_problem auto problem, size_t samples)
+      : front{gallery::pareto_frontier<frontier<real>>(problem, samples)} {
+    const auto m = front.objective_count();
+    constexpr auto infinity = std::numeric_limits<real>::infinity();
+    std::vector<real> low(m, infinity);
+    point.assign(m, -infinity);
+    for (size_t i = 0; i < front.sample_count(); ++i)
+      for (size_t j = 0; j < m; ++j) {
+        const auto y = front.objectives(i)[j];
+        low[j] = std::min(low[j], y);
+        point[j] = std::max(point[j], y);
+      }
+    for (size_t j = 0; j < m; ++j)
+      point[j] += real(0.1) * std::max(point[j] - low[j], real(1e-6));
+    hypervolume = pareto::hypervolume(front, point);
+  }
+
+  frontier<real> front{};
+  std::vector<real> point{};
+  real hypervolume = 0;
+};
+
+/// Quality and cost of an optimizer at one point in time. Times and counters
+/// only contain the work of the optimizer, including its construction, and
+/// not the computation of the quality indicators. CPU time is summed over
+/// all threads of the process.
+struct checkpoint {
+  size_t evaluations = 0;
+  double cpu_seconds = 0;
+  double wall_seconds = 0;
+  hardware_counters counters{};
+  /// Hypervolume divided by the hypervolume of the reference frontier
+  double hypervolume_ratio = 0;
+  double igd = 0;
+  double igd_plus = 0;
+  size_t front_size = 0;
+};
+
+/// Constructs an optimizer for the counted problem by calling
+/// 'make(problem, rng)' and advances it by its 'optimize' function until the
+/// given number of evaluations is exceeded. Checkpoints are taken after the
+/// construction, if it evaluated samples, and at 'checkpoints' evaluation
+/// counts that are geometrically distributed up to the budget. Because
+/// iterations of optimizers evaluate different numbers of samples, the
+/// iterations of every advance are estimated from the evaluations observed so
+/// far, such that checkpoints may slightly overshoot their evaluation count.
+template <generic::real real>
+auto convergence(generic::problem auto problem,
+                 const reference<real>& ref,
+                 generic::random_number_generator auto&& rng,
+                 auto&& make,
+                 size_t budget,
+                 size_t checkpoints) {
+  using namespace std;
+  using wall_clock = chrono::steady_clock;
+
+  counted_problem counted{problem};
+  perf_counters counters{};
+  vector<checkpoint> result{};
+  checkpoint cost{};
+
+  const auto measure = [&](auto&& f) {
+    const auto start_counters = counters.read();
+    const auto start_cpu = clock();
+    const auto start_wall = wall_clock::now();
+    f();
+    cost.wall_seconds +=
+        chrono::duration<double>(wall_clock::now() - start_wall).count();
+    cost.cpu_seconds += double(clock() - start_cpu) / CLOCKS_PER_SEC;
+    cost.counters += counters.read() - start_counters;
+    cost.evaluations = counted.evaluations();
+  };
+
+  const auto record = [&](const auto& optimizer) {
+    const auto front = optimizer.template frontier_cast<frontier<real>>();
+    auto& c = result.emplace_back(cost);
+    c.front_size = front.sample_count();
+    c.hypervolume_ratio =
+        pareto::hypervolume(front, ref.point) / ref.hypervolume;
+    c.igd = inverted_generational_distance(front, ref.front);
+    c.igd_plus = inverted_generational_distance_plus(front, ref.front);
+  };
+
+  // Construction already evaluates the initial population of most optimizers.
+  // Guaranteed copy elision allows optimizers that cannot be moved.
+  struct holder {
+    decltype(make(counted, rng)) optimizer;
+  };
+  unique_ptr<holder> h{};
+  measure([&] { h.reset(new holder{make(counted, rng)}); });
+  auto& optimizer = h->optimizer;
+  const auto initial = cost.evaluations;
+  if (initial > 0) record(optimizer);
+
+  const auto first = max<size_t>(initial, 1);
+  size_t iterations = 0;
+  bool finished = false;
+  for (size_t k = 1; k <= checkpoints && !finished; ++k) {
+    const auto target =
+        min(budget, size_t(ceil(first * pow(double(budget) / first,
+                                            double(k) / checkpoints))));
+    while (cost.evaluations < target) {
+      // Evaluations per iteration are unknown before the first advance.
+      const auto done = cost.evaluations - initial;
+      const auto rate = iterations ? double(done) / iterations : 0.0;
+      const auto remaining = double(target - cost.evaluations);
+      const auto step = (rate > 0) ? max(size_t(1), size_t(remaining / rate))
+                                   : size_t(1);
+      const auto old = cost.evaluations;
+      measure([&] { optimizer.optimize(rng, step); });
+      iterations += step;
+      // Stop optimizers that have finished and do not evaluate anymore.
+      if (cost.evaluations == old) {
+        finished = true;
+        break;
+      }
+    }
+    // Overshooting may have already passed the evaluations of this checkpoint.
+    if (result.empty() || result.back().evaluations != cost.evaluations)
+      record(optimizer);
+    finished = finished || (cost.evaluations >= budget);
+  }
+  return result;
+}
+
+}  // namespace lyrahgames::pareto::benchmark
@@ -0,0 +1,115 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <span>
+#include <vector>
+//
+#include <lyrahgames/pareto/frontier.hpp>
+#include <lyrahgames/pareto/hypervolume.hpp>
+#include <lyrahgames/pareto/meta.hpp>
+
+namespace lyrahgames::pareto {
+
+/// Limits of anytime optimizations that stop as soon as one of them is
+/// reached. The estimated Pareto front stays available at every time. A zero
+/// number of evaluations does not limit them. No evaluation is started after
+/// the deadline. A positive stagnation stops the optimization after that many
+/// consecutive steps, like generations, without progress. See
+/// 'stagnation_detector'.
+struct budget {
+  using clock = std::chrono::steady_clock;
+
+  size_t evaluations = 0;
+  clock::time_point deadline = clock::time_point::max();
+  size_t stagnation = 0;
+  double tolerance = 0;
+
+  /// Returns the number of evaluations that may still be done after the
+  /// given number of evaluations.
+  size_t remaining(size_t used) const noexcept {
+    if (evaluations == 0) return std::numeric_limits<size_t>::max();
+    return (used < evaluations) ? evaluations - used : 0;
+  }
+
+  /// Checks if the deadline has passed. Without deadline, the clock is not
+  /// read at all.
+  bool expired() const noexcept {
+    return (deadline != clock::time_point::max()) && (clock::now() >= deadline);
+  }
+};
+
+/// Detects the stagnation of an estimated Pareto front. A step without change
+/// of the front does not make progress. For a positive tolerance, a changed
+/// front additionally has to increase the best hypervolume seen so far by
+/// more than this fraction. The hypervolume is only computed for changed
+/// fronts. Its reference point is fixed at the first computation to the
+/// nadir point of the front shifted by the range of the front.
+template <generic::real T>
+class stagnation_detector {
+ public:
+  using real = T;
+
+  stagnation_detector() = default;
+  explicit stagnation_detector(const budget& limits)
+      : patience{limits.stagnation}, tolerance{limits.tolerance} {}
+
+  /// Forgets all steps and the reference point, like after a change of the
+  /// objectives.
+  void reset() noexcept {
+    steps = 0;
+    volume = 0;
+    reference.clear();
+  }
+
+  /// Registers the next step. The objectives of the current front with 'm'
+  /// values per point are returned by 'front()' as contiguous range. It is
+  /// only called if the hypervolume has to be computed.
+  void update(bool changed, size_t m, auto&& front) {
+    if (patience == 0) return;
+    if (changed && tolerance > 0) changed = improved(m, front());
+    steps = changed ? 0 : steps + 1;
+  }
+
+  /// Returns true if there has been no progress for too many steps.
+  bool stagnated() const noexcept { return patience > 0 && steps >= patience; }
+
+ private:
+  bool improved(size_t m, std::span<const real> y) {
+    using namespace std;
+    const auto count = y.size() / m;
+    if (count == 0) return false;
+    if (reference.empty()) {
+      vector<real> ideal(y.begin(), y.begin() + m);
+      reference.assign(y.begin(), y.begin() + m);
+      for (size_t i = 1; i < count; ++i) {
+        for (size_t j = 0; j < m; ++j) {
+          ideal[j] = min(ideal[j], y[m * i + j]);
+          reference[j] = max(reference[j], y[m * i + j]);
+        }
+      }
+      for (size_t j = 0; j < m; ++j) {
+        const auto range = reference[j] - ideal[j];
+        reference[j] += (range > 0) ? range : real(1);
+      }
+    }
+    frontier<real> points{count, 0, m};
+    for (size_t i = 0; i < count; ++i)
+      copy_n(&y[m * i], m, points.objectives_iterator(i));
+    const auto v = hypervolume(points, reference, 1);
+    const auto result = v > volume * (1 + tolerance);
+    volume = max(volume, v);
+    return result;
+  }
+
+  size_t patience = 0;
+  double tolerance = 0;
+  /// Number of consecutive steps without progress
+  size_t steps = 0;
+  /// Best hypervolume so far and its reference point
+  real volume = 0;
+  std::vector<real> reference{};
+};
+
+}  // namespace lyrahgames::pareto
@@ -31,4 +31,19 @@ inline bool dominates(const T& x, const U& y) noexcept  //
   // return false;
 }
 
+/// Evaluates if the point given by the range 'x' weakly Pareto-dominates the
+/// point given by the range 'y'. That is, 'x' is nowhere worse than 'y'.
+template <std::ranges::input_range T, std::ranges::input_range U>
+inline bool weakly_dominates(const T& x, const U& y) noexcept  //
+    requires(std::totally_ordered_with<std::ranges::range_value_t<T>,
+                                       std::ranges::range_value_t<U>>) {
+  using namespace std;
+  assert(ranges::size(x) == ranges::size(y));
+
+  auto yit = ranges::begin(y);
+  for (auto xit = ranges::begin(x); xit != ranges::end(x); ++xit, ++yit)
+    if (*xit > *yit) return false;
+  return true;
+}
+
 }  // namespace lyrahgames::pareto
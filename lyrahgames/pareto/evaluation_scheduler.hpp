@@ -0,0 +1,201 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <span>
+#include <thread>
+#include <vector>
+//
+#include <lyrahgames/pareto/parallel.hpp>
+#include <lyrahgames/pareto/tracing.hpp>
+
+namespace lyrahgames::pareto {
+
+/// Work-Stealing Scheduler for Evaluations with Varying Cost
+/// Every thread owns a queue of evaluations. If costs have been predicted, the
+/// evaluations are dealt to the queues from the most to the least expensive
+/// one such that long evaluations are started first. Threads take chunks from
+/// the front of their own queue and steal the back half of another queue when
+/// their own queue is empty. Chunks adapt to the cost of an evaluation. Cheap
+/// evaluations are taken in larger chunks to reduce synchronization, whereas
+/// expensive evaluations are taken one by one to keep them stealable. The
+/// duration of every evaluation is measured and can be used to predict costs
+/// of similar evaluations later on.
+class evaluation_scheduler {
+ public:
+  /// Structure to provide easy intialization of the scheduler. The grain
+  /// gives the amount of work in seconds a thread takes from its queue at
+  /// once if evaluations are cheap.
+  struct configuration {
+    size_t threads = default_thread_count();
+    double grain = 50e-6;
+  };
+
+  evaluation_scheduler() = default;
+  explicit evaluation_scheduler(configuration config)
+      : threads(std::max<size_t>(1, config.threads)), grain(config.grain) {}
+
+  auto thread_count() const noexcept { return threads; }
+
+  /// Calls 'f(thread, index)' for every index in [0, count), where 'thread'
+  /// lies in [0, threads). 'predicted' optionally provides the estimated cost
+  /// of every index in seconds. Non-positive values mark unknown costs. If
+  /// 'measured' is not empty, the duration of every call in seconds is stored
+  /// there. The first exception thrown by 'f' is rethrown after all threads
+  /// have stopped.
+  template <typename function>
+  void run(size_t count,
+           function&& f,
+           std::span<const double> predicted = {},
+           std::span<double> measured = {}) {
+    using namespace std;
+    using clock = chrono::steady_clock;
+
+    // Dispatch expensive evaluations first.
+    tasks.resize(count);
+    iota(tasks.begin(), tasks.end(), size_t{0});
+    if (!predicted.empty())
+      stable_sort(tasks.begin(), tasks.end(), [&](auto i, auto j) {
+        return predicted[i] > predicted[j];
+      });
+
+    const auto call = [&](size_t thread, size_t index) {
+      const auto start = clock::now();
+      f(thread, index);
+      const auto stop = clock::now();
+      // Reuse the measurement such that tracing adds no further clock reads.
+      if constexpr (tracing::enabled)
+        tracing::record("scheduler::evaluate", tracing::to_timestamp(start),
+                        tracing::to_timestamp(stop));
+      const auto duration = chrono::duration<double>(stop - start).count();
+      if (!measured.empty()) measured[index] = duration;
+      return duration;
+    };
+
+    const auto t = min(threads, count);
+    if (t <= 1) {
+      for (auto index : tasks)
+        call(0, index);
+      return;
+    }
+
+    // Deal the sorted tasks round-robin such that every queue is sorted and
+    // gets the same share of expensive tasks. Queues are contiguous ranges of
+    // 'order'. A thief redirects its empty queue into the stolen range.
+    order.resize(count);
+    auto queues = make_unique<queue[]>(t);
+    for (size_t q = 0, i = 0; q < t; ++q) {
+      queues[q].head = i;
+      for (auto k = q; k < count; k += t)
+        order[i++] = tasks[k];
+      queues[q].tail = i;
+    }
+
+    atomic<bool> stop{false};
+    exception_ptr error{};
+    mutex error_mutex{};
+
+    const auto cost = [&](size_t index, double mean) {
+      return (!predicted.empty() && predicted[index] > 0) ? predicted[index]
+                                                          : mean;
+    };
+
+    const auto work = [&](size_t thread) {
+      auto& own = queues[thread];
+      // Running mean of the measured durations of this thread
+      double mean = 0;
+      size_t samples = 0;
+      try {
+        while (!stop.load(memory_order_relaxed)) {
+          size_t first, last;
+          {
+            scoped_lock lock{own.mutex};
+            // Take tasks until the grain is reached, but at most half of the
+            // queue such that other threads can still steal.
+            const auto remaining = own.tail - own.head;
+            first = last = own.head;
+            double chunk = 0;
+            while (last < own.tail && (last == first || chunk < grain) &&
+                   2 * (last - first) < remaining) {
+              chunk += cost(order[last], mean);
+              ++last;
+            }
+            own.head = last;
+          }
+
+          if (first == last) {
+            if (!steal(queues.get(), t, thread)) break;
+            continue;
+          }
+
+          for (auto i = first; i < last; ++i) {
+            if (stop.load(memory_order_relaxed)) break;
+            mean += (call(thread, order[i]) - mean) / double(++samples);
+          }
+        }
+      } catch (...) {
+        scoped_lock lock{error_mutex};
+        if (!error) error = current_exception();
+        stop.store(true, memory_order_relaxed);
+      }
+    };
+
+    vector<std::thread> workers{};
+    workers.reserve(t - 1);
+    for (size_t i = 1; i < t; ++i)
+      workers.emplace_back(work, i);
+    work(0);
+    {
+      // Time the calling thread waits for the last evaluations
+      LYRAHGAMES_PARETO_TRACE_SCOPE("scheduler::join");
+      for (auto& worker : workers)
+        worker.join();
+    }
+
+    if (error) rethrow_exception(error);
+  }
+
+ private:
+  /// Range of the task order owned by one thread
+  struct alignas(64) queue {
+    std::mutex mutex{};
+    size_t head = 0;
+    size_t tail = 0;
+  };
+
+  /// Moves the back half of the first non-empty other queue into the queue
+  /// of the given thread. Returns false if there was nothing left to steal.
+  static bool steal(queue* queues, size_t count, size_t thread) {
+    LYRAHGAMES_PARETO_TRACE_SCOPE("scheduler::steal");
+    using namespace std;
+    for (size_t k = 1; k < count; ++k) {
+      auto& victim = queues[(thread + k) % count];
+      size_t first, last;
+      {
+        scoped_lock lock{victim.mutex};
+        const auto remaining = victim.tail - victim.head;
+        if (remaining == 0) continue;
+        last = victim.tail;
+        first = victim.tail - (remaining + 1) / 2;
+        victim.tail = first;
+      }
+      scoped_lock lock{queues[thread].mutex};
+      queues[thread].head = first;
+      queues[thread].tail = last;
+      return true;
+    }
+    return false;
+  }
+
+  size_t threads = default_thread_count();
+  double grain = 50e-6;
+  /// Scratch memory for the task order
+  std::vector<size_t> tasks{};
+  std::vector<size_t> order{};
+};
+
+}  // namespace lyrahgames::pareto
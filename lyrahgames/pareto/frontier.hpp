@@ -33,52 +33,48 @@ struct frontier {
 
   /// Returns range of parameters to the sample identified by 'index'.
   auto parameters(size_t index) noexcept {
-    return std::span{&parameters_data[n * index],
-                     &parameters_data[n * (index + 1)]};
+    return std::span{parameters_data.data() + n * index, n};
   }
 
   /// Returns range of parameters to the sample identified by 'index'.
   /// Constant overload.
   auto parameters(size_t index) const noexcept {
-    return std::span{&parameters_data[n * index],
-                     &parameters_data[n * (index + 1)]};
+    return std::span{parameters_data.data() + n * index, n};
   }
 
   /// Returns range of objectives to the sample identified by 'index'.
   auto objectives(size_t index) noexcept {
-    return std::span{&objectives_data[m * index],
-                     &objectives_data[m * (index + 1)]};
+    return std::span{objectives_data.data() + m * index, m};
   }
 
   /// Returns range of parameters to the sample identified by 'index'.
   /// Constant overload.
   auto objectives(size_t index) const noexcept {
-    return std::span{&objectives_data[m * index],
-                     &objectives_data[m * (index + 1)]};
+    return std::span{objectives_data.data() + m * index, m};
   }
 
   /// Returns iterator to the beginning of the parameters
   /// of the sample identified by 'index'.
   auto parameters_iterator(size_t index) noexcept {
-    return &parameters_data[n * index];
+    return parameters_data.data() + n * index;
   }
 
   /// Returns iterator to the beginning of the parameters
   /// of the sample identified by 'index'. Constant overload.
   auto parameters_iterator(size_t index) const noexcept {
-    return &parameters_data[n * index];
+    return parameters_data.data() + n * index;
   }
 
   /// Returns iterator to the beginning of the objectives
   /// of the sample identified by 'index'.
   auto objectives_iterator(size_t index) noexcept {
-    return &objectives_data[m * index];
+    return objectives_data.data() + m * index;
   }
 
   /// Returns iterator to the beginning of the objectives
   /// of the sample identified by 'index'. Constant overload.
   auto objectives_iterator(size_t index) const noexcept {
-    return &objectives_data[m * index];
+    return objectives_data.data() + m * index;
   }
 
   /// Sample Count
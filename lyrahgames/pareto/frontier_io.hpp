@@ -0,0 +1,56 @@
+#pragma once
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+//
+#include <lyrahgames/pareto/meta.hpp>
+
+namespace lyrahgames::pareto {
+
+/// Writes the given frontier as text to the given stream. The first line
+/// contains the sample, parameter, and objective count. Every following line
+/// contains the parameters and then the objectives of one sample. Values are
+/// written with full precision such that reading them back gives identical
+/// values.
+void write_frontier(std::ostream& os, const generic::frontier auto& frontier) {
+  using namespace std;
+  using real = typename remove_cvref_t<decltype(frontier)>::real;
+  const auto n = frontier.parameter_count();
+  const auto m = frontier.objective_count();
+  const auto precision = os.precision(numeric_limits<real>::max_digits10);
+  os << frontier.sample_count() << ' ' << n << ' ' << m << '\n';
+  for (size_t i = 0; i < frontier.sample_count(); ++i) {
+    auto x = frontier.parameters_iterator(i);
+    for (size_t j = 0; j < n; ++j, ++x)
+      os << *x << ' ';
+    auto y = frontier.objectives_iterator(i);
+    for (size_t j = 0; j < m; ++j, ++y)
+      os << *y << ((j + 1 < m) ? ' ' : '\n');
+  }
+  os.precision(precision);
+}
+
+/// Reads a frontier that has been written by 'write_frontier' from the given
+/// stream. Throws an exception if the input is malformed.
+template <generic::frontier frontier_type>
+auto read_frontier(std::istream& is) {
+  using namespace std;
+  size_t s, n, m;
+  if (!(is >> s >> n >> m))
+    throw runtime_error("read_frontier: failed to read the frontier sizes");
+  frontier_type frontier{s, n, m};
+  for (size_t i = 0; i < s; ++i) {
+    auto x = frontier.parameters_iterator(i);
+    for (size_t j = 0; j < n; ++j, ++x)
+      is >> *x;
+    auto y = frontier.objectives_iterator(i);
+    for (size_t j = 0; j < m; ++j, ++y)
+      is >> *y;
+  }
+  if (!is) throw runtime_error("read_frontier: unexpected end of input");
+  return frontier;
+}
+
+}  // namespace lyrahgames::pareto
@@ -0,0 +1,243 @@
+#pragma once
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <numbers>
+#include <ranges>
+#include <span>
+#include <vector>
+//
+#include <lyrahgames/pareto/meta.hpp>
+//
+#include <lyrahgames/pareto/gallery/scalable.hpp>
+
+namespace lyrahgames::pareto::gallery {
+
+/// Scalable test problems DTLZ1 to DTLZ7 of Deb, Thiele, Laumanns, and
+/// Zitzler selected by 'K'. The first 'm - 1' parameters determine the
+/// position on the Pareto frontier and the remaining ones its distance.
+template <std::floating_point T,
+          size_t K,
+          size_t M = dynamic,
+          size_t N = dynamic>
+class deb_thiele_laumanns_zitzler_problem : public scalable_problem<T, M, N> {
+  static_assert((1 <= K) && (K <= 7), "There are only seven DTLZ problems.");
+  using base = scalable_problem<T, M, N>;
+
+ public:
+  using real = T;
+  using base::objective_count;
+  using base::parameter_count;
+
+  /// Number of distance parameters proposed for the problem
+  static constexpr size_t distance_parameters =
+      (K == 1) ? 5 : ((K == 7) ? 20 : 10);
+
+  /// If no parameter count is given, the proposed number of distance
+  /// parameters is used.
+  explicit deb_thiele_laumanns_zitzler_problem(
+      size_t objectives = (M != dynamic) ? M : 3,
+      size_t parameters = N)
+      : base(objectives,
+             parameters ? parameters : objectives - 1 + distance_parameters) {}
+
+  static constexpr real box_min(size_t index) { return 0; }
+  static constexpr real box_max(size_t index) { return 1; }
+
+  void evaluate(const generic::range<real> auto& x,
+                generic::range<real> auto&& y) const {
+    assert(std::ranges::size(x) == parameter_count());
+    assert(std::ranges::size(y) == objective_count());
+    detail::evaluate_sample(*this, x, y);
+  }
+
+  /// Evaluates contiguously stored samples and computes their distance
+  /// functions for blocks of samples at once.
+  void evaluate_batch(std::span<const real> x, std::span<real> y) const {
+    detail::evaluate_samples(*this, x, y);
+  }
+
+  static constexpr size_t distance_count() { return 1; }
+
+  void distances(auto x, size_t lanes, real* g) const {
+    const auto m = objective_count();
+    const auto n = parameter_count();
+    for (size_t l = 0; l < lanes; ++l)
+      g[l] = 0;
+    for (size_t j = m - 1; j < n; ++j)
+      for (size_t l = 0; l < lanes; ++l)
+        g[l] += distance_term(x[n * l + j]);
+    for (size_t l = 0; l < lanes; ++l)
+      g[l] = distance(g[l]);
+  }
+
+  void shape(auto x, const real* distance, auto y) const {
+    using namespace std;
+    constexpr auto pi = numbers::pi_v<real>;
+    const auto m = objective_count();
+    const auto g = *distance;
+    if constexpr (K == 1) {
+      real p = real(0.5) * (1 + g);
+      for (size_t r = 0; r < m - 1; ++r) {
+        y[m - 1 - r] = p * (1 - x[r]);
+        p *= x[r];
+      }
+      y[0] = p;
+    } else if constexpr (K == 7) {
+      real h = m;
+      for (size_t j = 0; j < m - 1; ++j) {
+        y[j] = x[j];
+        h -= x[j] / (1 + g) * (1 + sin(3 * pi * x[j]));
+      }
+      y[m - 1] = (1 + g) * h;
+    } else {
+      real p = 1 + g;
+      for (size_t r = 0; r < m - 1; ++r) {
+        real theta;
+        if constexpr (K == 4)
+          theta = pow(real(x[r]), real(100)) * pi / 2;
+        else if constexpr ((K == 5) || (K == 6))
+          theta = (r == 0) ? x[r] * pi / 2
+                           : pi / (4 * (1 + g)) * (1 + 2 * g * x[r]);
+        else
+          theta = x[r] * pi / 2;
+        y[m - 1 - r] = p * sin(theta);
+        p *= cos(theta);
+      }
+      y[0] = p;
+    }
+  }
+
+  /// Updates the objectives of the parent for changes of the given
+  /// parameters. The distance of the parent is recovered from its objectives
+  /// and only changed by the terms of changed distance parameters. The shape
+  /// is computed from scratch in O(m).
+  void evaluate_delta(const generic::range<real> auto& parent_x,
+                      const generic::range<real> auto& parent_y,
+                      const std::ranges::input_range auto& changed,
+                      const generic::range<real> auto& x,
+                      generic::range<real> auto&& y) const {
+    using namespace std;
+    constexpr auto pi = numbers::pi_v<real>;
+    const auto m = objective_count();
+
+    real g = 0;
+    if constexpr (K == 1) {
+      // Objectives sum up to (1 + g) / 2.
+      for (size_t j = 0; j < m; ++j)
+        g += parent_y[j];
+      g = 2 * g - 1;
+    } else if constexpr (K == 7) {
+      // The last objective is (1 + g) m minus a sum over the positions.
+      g = parent_y[m - 1];
+      for (size_t j = 0; j < m - 1; ++j)
+        g += parent_x[j] * (1 + sin(3 * pi * parent_x[j]));
+      g = g / m - 1;
+    } else {
+      // Objectives lie on the sphere with radius 1 + g.
+      for (size_t j = 0; j < m; ++j)
+        g += parent_y[j] * parent_y[j];
+      g = sqrt(g) - 1;
+    }
+
+    auto sum = distance_sum(g);
+    for (size_t i : changed)
+      if (i >= m - 1) sum += distance_term(x[i]) - distance_term(parent_x[i]);
+    g = distance(sum);
+    shape(ranges::begin(x), &g, ranges::begin(y));
+  }
+
+  /// Maps the position 't' in the unit cube with 'm - 1' dimensions to
+  /// Pareto-optimal parameters.
+  void pareto_optimal_parameters(const generic::range<real> auto& t,
+                                 generic::range<real> auto&& x) const {
+    assert(std::ranges::size(x) == parameter_count());
+    const auto m = objective_count();
+    for (size_t j = 0; j < m - 1; ++j)
+      x[j] = t[j];
+    for (size_t j = m - 1; j < parameter_count(); ++j)
+      x[j] = (K <= 5) ? real(0.5) : real(0);
+  }
+
+  /// Returns about 'count' samples of the Pareto frontier with 'm' objectives
+  /// per sample. The disconnected frontier of DTLZ7 contains dominated
+  /// samples.
+  auto pareto_front(size_t count) const {
+    using namespace std;
+    const auto m = objective_count();
+    if constexpr (K == 1)
+      return detail::linear_front<real>(m, count, real(0.5));
+    else if constexpr (K == 7)
+      return detail::disconnected_front<real>(m, count, real(1));
+    else if constexpr ((K == 5) || (K == 6)) {
+      // The frontier is a curve only determined by the first parameter.
+      vector<real> result(m * count);
+      vector<real> x(m, real(0.5));
+      const real g = 0;
+      for (size_t i = 0; i < count; ++i) {
+        x[0] = (count > 1) ? real(i) / (count - 1) : real(0);
+        shape(x.data(), &g, &result[m * i]);
+      }
+      return result;
+    } else
+      return detail::spherical_front<real>(m, count,
+                                           [](size_t) { return real(1); });
+  }
+
+ private:
+  /// Term of one distance parameter in the sum of the distance function
+  static real distance_term(real v) {
+    using namespace std;
+    constexpr auto pi = numbers::pi_v<real>;
+    if constexpr ((K == 1) || (K == 3)) {
+      const auto d = v - real(0.5);
+      return d * d - cos(20 * pi * d);
+    } else if constexpr (K == 6)
+      return pow(v, real(0.1));
+    else if constexpr (K == 7)
+      return v;
+    else {
+      const auto d = v - real(0.5);
+      return d * d;
+    }
+  }
+
+  /// Distance function 'g' given by the sum of all distance terms
+  real distance(real sum) const {
+    const auto k = real(parameter_count() - objective_count() + 1);
+    if constexpr ((K == 1) || (K == 3))
+      return 100 * (k + sum);
+    else if constexpr (K == 7)
+      return 1 + 9 * sum / k;
+    else
+      return sum;
+  }
+
+  /// Inverse of 'distance'
+  real distance_sum(real g) const {
+    const auto k = real(parameter_count() - objective_count() + 1);
+    if constexpr ((K == 1) || (K == 3))
+      return g / 100 - k;
+    else if constexpr (K == 7)
+      return (g - 1) * k / 9;
+    else
+      return g;
+  }
+};
+
+template <std::floating_point real, size_t M = dynamic, size_t N = dynamic>
+using dtlz1 = deb_thiele_laumanns_zitzler_problem<real, 1, M, N>;
+template <std::floating_point real, size_t M = dynamic, size_t N = dynamic>
+using dtlz2 = deb_thiele_laumanns_zitzler_problem<real, 2, M, N>;
+template <std::floating_point real, size_t M = dynamic, size_t N = dynamic>
+using dtlz3 = deb_thiele_laumanns_zitzler_problem<real, 3, M, N>;
+template <std::floating_point real, size_t M = dynamic, size_t N = dynamic>
+using dtlz4 = deb_thiele_laumanns_zitzler_problem<real, 4, M, N>;
+template <std::floating_point real, size_t M = dynamic, size_t N = dynamic>
+using dtlz5 = deb_thiele_laumanns_zitzler_problem<real, 5, M, N>;
+template <std::floating_point real, size_t M = dynamic, size_t N = dynamic>
+using dtlz6 = deb_thiele_laumanns_zitzler_problem<real, 6, M, N>;
+template <std::floating_point real, size_t M = dynamic, size_t N = dynamic>
+using dtlz7 = deb_thiele_laumanns_zitzler_problem<real, 7, M, N>;
+
+}  // namespace lyrahgames::pareto::gallery
@@ -36,6 +36,15 @@ struct fonseca_fleming_problem {
     y[1] = 1 - exp(-q);
   }
 
+  /// Maps the curve parameter 't' in [0, 1] to Pareto-optimal parameters.
+  void pareto_optimal_parameters(real t, generic::range<real> auto&& x) const {
+    using namespace std;
+    assert(ranges::size(x) == parameter_count());
+    const auto a = 1 / sqrt(real(n));
+    for (size_t i = 0; i < n; ++i)
+      x[i] = lerp(-a, a, t);
+  }
+
   size_t n{3};
 };
 
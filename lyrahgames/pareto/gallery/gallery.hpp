@@ -1,9 +1,15 @@
 #pragma once
 
+#include <lyrahgames/pareto/gallery/dtlz.hpp>
 #include <lyrahgames/pareto/gallery/fonseca_fleming.hpp>
 #include <lyrahgames/pareto/gallery/kursawe.hpp>
+#include <lyrahgames/pareto/gallery/latency.hpp>
+#include <lyrahgames/pareto/gallery/lsmop.hpp>
+#include <lyrahgames/pareto/gallery/pareto_frontier.hpp>
 #include <lyrahgames/pareto/gallery/pawellek.hpp>
 #include <lyrahgames/pareto/gallery/poloni.hpp>
+#include <lyrahgames/pareto/gallery/scalable.hpp>
 #include <lyrahgames/pareto/gallery/schaffer.hpp>
 #include <lyrahgames/pareto/gallery/viennet.hpp>
+#include <lyrahgames/pareto/gallery/wfg.hpp>
 #include <lyrahgames/pareto/gallery/zitzler_deb_thiele.hpp>
@@ -0,0 +1,68 @@
+#pragma once
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <concepts>
+#include <ranges>
+#include <thread>
+//
+#include <lyrahgames/pareto/meta.hpp>
+
+namespace lyrahgames::pareto::gallery {
+
+/// Wraps a problem and delays every evaluation by a latency depending on one
+/// of its parameters. The latency grows linearly from 'min_latency' at the
+/// lower to 'max_latency' at the upper bound of the chosen parameter. Hence,
+/// samples close to each other in parameter space have similar costs. If
+/// 'busy' is set, the thread spins instead of sleeping to mimic compute-bound
+/// evaluations. This is used to benchmark load balancing locally.
+template <generic::problem T>
+struct latency_problem {
+  using problem_type = T;
+  using real = typename problem_type::real;
+  using duration = std::chrono::nanoseconds;
+
+  size_t parameter_count() const { return problem.parameter_count(); }
+  size_t objective_count() const { return problem.objective_count(); }
+
+  real box_min(size_t index) const { return problem.box_min(index); }
+  real box_max(size_t index) const { return problem.box_max(index); }
+
+  /// Returns the latency of an evaluation with the given parameters.
+  duration latency(const generic::range<real> auto& x) const {
+    using namespace std;
+    assert(parameter < parameter_count());
+    const auto a = box_min(parameter);
+    const auto b = box_max(parameter);
+    const auto t = clamp((x[parameter] - a) / (b - a), real(0), real(1));
+    return min_latency +
+           duration(llround(t * real((max_latency - min_latency).count())));
+  }
+
+  void evaluate(const generic::range<real> auto& x,
+                generic::range<real> auto&& y) {
+    using namespace std;
+    using clock = chrono::steady_clock;
+    const auto end = clock::now() + latency(x);
+    if (busy)
+      while (clock::now() < end) {
+      }
+    else
+      this_thread::sleep_until(end);
+    problem.evaluate(x, y);
+  }
+
+  /// Maps the curve parameter 't' in [0, 1] to Pareto-optimal parameters.
+  /// Only available if the wrapped problem provides this function.
+  void pareto_optimal_parameters(real t, generic::range<real> auto&& x) const {
+    problem.pareto_optimal_parameters(t, x);
+  }
+
+  problem_type problem{};
+  duration min_latency = std::chrono::microseconds{100};
+  duration max_latency = std::chrono::milliseconds{1};
+  size_t parameter = 0;
+  bool busy = false;
+};
+
+}  // namespace lyrahgames::pareto::gallery
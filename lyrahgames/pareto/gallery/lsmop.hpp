@@ -0,0 +1,318 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <numbers>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <vector>
+//
+#include <lyrahgames/pareto/meta.hpp>
+//
+#include <lyrahgames/pareto/gallery/scalable.hpp>
+
+namespace lyrahgames::pareto::gallery {
+
+namespace detail {
+
+/// Basis functions of the distances of LSMOP problems
+enum class lsmop_basis {
+  sphere,
+  griewank,
+  schwefel,
+  rastrigin,
+  rosenbrock,
+  ackley
+};
+
+}  // namespace detail
+
+/// Scalable large-scale test problems LSMOP1 to LSMOP9 of Cheng, Jin, Olhofer,
+/// and Sendhoff selected by 'K'. The first 'm - 1' parameters determine the
+/// position on the Pareto frontier. The remaining ones are linked to the first
+/// parameter and split into 'm' groups of 'subcomponents' subcomponents whose
+/// sizes follow a chaotic sequence. Group 'j' contributes the distance of
+/// objective 'j'. Parameters left over by the rounding of subcomponent sizes
+/// are added to the last subcomponent, instead of being dropped, such that
+/// the given parameter count is kept.
+template <std::floating_point T,
+          size_t K,
+          size_t M = dynamic,
+          size_t N = dynamic>
+class large_scale_problem : public scalable_problem<T, M, N> {
+  static_assert((1 <= K) && (K <= 9), "There are only nine LSMOP problems.");
+  using base = scalable_problem<T, M, N>;
+
+ public:
+  using real = T;
+  using base::objective_count;
+  using base::parameter_count;
+
+  /// Number of subcomponents of every group of distance parameters
+  static constexpr size_t subcomponents = 5;
+
+  /// If no parameter count is given, '100 m' parameters are used.
+  explicit large_scale_problem(size_t objectives = (M != dynamic) ? M : 3,
+                               size_t parameters = N)
+      : base(objectives, parameters ? parameters : 100 * objectives) {
+    const auto m = objective_count();
+    const auto n = parameter_count();
+    std::vector<double> c(m);
+    c[0] = 3.8 * 0.1 * (1 - 0.1);
+    for (size_t j = 1; j < m; ++j)
+      c[j] = 3.8 * c[j - 1] * (1 - c[j - 1]);
+    double sum = 0;
+    for (auto v : c)
+      sum += v;
+
+    bounds.assign(m * subcomponents + 1, m - 1);
+    for (size_t j = 0; j < m; ++j) {
+      const auto size =
+          size_t(std::floor(c[j] / sum * double(n - m + 1) / subcomponents));
+      if (size == 0)
+        throw std::invalid_argument(
+            "Too few parameters for the subcomponents of all objectives.");
+      for (size_t s = 0; s < subcomponents; ++s) {
+        const auto i = j * subcomponents + s;
+        bounds[i + 1] = bounds[i] + size;
+      }
+    }
+    bounds.back() = n;
+  }
+
+  static constexpr real box_min(size_t index) { return 0; }
+  real box_max(size_t index) const noexcept {
+    return (index < objective_count() - 1) ? 1 : 10;
+  }
+
+  void evaluate(const generic::range<real> auto& x,
+                generic::range<real> auto&& y) const {
+    assert(std::ranges::size(x) == parameter_count());
+    assert(std::ranges::size(y) == objective_count());
+    detail::evaluate_sample(*this, x, y);
+  }
+
+  /// Evaluates contiguously stored samples and computes the distances of
+  /// their subcomponents for blocks of samples at once.
+  void evaluate_batch(std::span<const real> x, std::span<real> y) const {
+    detail::evaluate_samples(*this, x, y);
+  }
+
+  /// The position parameters form the first group and every subcomponent
+  /// forms its own group of interacting parameters.
+  size_t parameter_group_count() const noexcept {
+    return objective_count() * subcomponents + 1;
+  }
+  size_t parameter_group(size_t index) const noexcept {
+    return std::upper_bound(bounds.begin(), bounds.end(), index) -
+           bounds.begin();
+  }
+
+  /// Every objective has its own distance given by its group of parameters.
+  size_t distance_count() const noexcept { return objective_count(); }
+
+  void distances(auto x, size_t lanes, real* g) const {
+    assert(lanes <= batch_lanes);
+    const auto m = objective_count();
+    for (size_t l = 0; l < lanes; ++l)
+      for (size_t j = 0; j < m; ++j)
+        g[m * l + j] = 0;
+    for (size_t j = 0; j < m; ++j) {
+      for (size_t s = 0; s < subcomponents; ++s) {
+        const auto first = bounds[j * subcomponents + s];
+        const auto last = bounds[j * subcomponents + s + 1];
+        if (j % 2 == 0)
+          subcomponent<odd_basis>(x, lanes, first, last, j, g);
+        else
+          subcomponent<even_basis>(x, lanes, first, last, j, g);
+      }
+    }
+  }
+
+  void shape(auto x, const real* g, auto y) const {
+    using namespace std;
+    constexpr auto pi = numbers::pi_v<real>;
+    const auto m = objective_count();
+    if constexpr (K <= 4) {
+      real p = 1;
+      for (size_t r = 0; r < m - 1; ++r) {
+        y[m - 1 - r] = p * (1 - x[r]);
+        p *= x[r];
+      }
+      y[0] = p;
+      for (size_t j = 0; j < m; ++j)
+        y[j] *= 1 + g[j];
+    } else if constexpr (K <= 8) {
+      real p = 1;
+      for (size_t r = 0; r < m - 1; ++r) {
+        y[m - 1 - r] = p * sin(x[r] * pi / 2);
+        p *= cos(x[r] * pi / 2);
+      }
+      y[0] = p;
+      for (size_t j = 0; j < m; ++j)
+        y[j] *= 1 + g[j] + ((j + 1 < m) ? g[j + 1] : real(0));
+    } else {
+      real s = 1;
+      for (size_t j = 0; j < m; ++j)
+        s += g[j];
+      real h = m;
+      for (size_t j = 0; j < m - 1; ++j) {
+        y[j] = x[j];
+        h -= x[j] / (1 + s) * (1 + sin(3 * pi * x[j]));
+      }
+      y[m - 1] = (1 + s) * h;
+    }
+  }
+
+  /// Maps the position 't' in the unit cube with 'm - 1' dimensions to
+  /// Pareto-optimal parameters by solving the linkage for the minima of the
+  /// basis functions. If the solution lies outside of the box, it is clamped
+  /// and the parameters are not optimal.
+  void pareto_optimal_parameters(const generic::range<real> auto& t,
+                                 generic::range<real> auto&& x) const {
+    assert(std::ranges::size(x) == parameter_count());
+    const auto m = objective_count();
+    for (size_t j = 0; j < m - 1; ++j)
+      x[j] = t[j];
+    const real first = x[0];
+    for (size_t j = 0; j < m; ++j) {
+      const auto basis = (j % 2 == 0) ? odd_basis : even_basis;
+      const auto c =
+          (basis == detail::lsmop_basis::rosenbrock) ? real(1) : real(0);
+      for (auto i = bounds[j * subcomponents];
+           i < bounds[(j + 1) * subcomponents]; ++i)
+        x[i] = std::clamp((c + 10 * first) / linkage(i), real(0), real(10));
+    }
+  }
+
+  /// Returns about 'count' samples of the Pareto frontier with 'm' objectives
+  /// per sample. The disconnected frontier of LSMOP9 contains dominated
+  /// samples.
+  auto pareto_front(size_t count) const {
+    const auto m = objective_count();
+    if constexpr (K <= 4)
+      return detail::linear_front<real>(m, count, real(1));
+    else if constexpr (K <= 8)
+      return detail::spherical_front<real>(m, count,
+                                           [](size_t) { return real(1); });
+    else
+      return detail::disconnected_front<real>(m, count, real(1));
+  }
+
+ private:
+  /// Basis functions of groups with odd and even objective numbers
+  static constexpr auto odd_basis = [] {
+    using enum detail::lsmop_basis;
+    constexpr detail::lsmop_basis functions[] = {
+        sphere, griewank, rastrigin, ackley, sphere,
+        rosenbrock, ackley, griewank, sphere};
+    return functions[K - 1];
+  }();
+  static constexpr auto even_basis = [] {
+    using enum detail::lsmop_basis;
+    constexpr detail::lsmop_basis functions[] = {
+        sphere, schwefel, rosenbrock, griewank, sphere,
+        schwefel, rosenbrock, sphere, ackley};
+    return functions[K - 1];
+  }();
+
+  /// Factor of the linear or nonlinear linkage of parameter 'i' to the first
+  /// parameter
+  real linkage(size_t i) const noexcept {
+    const auto r = real(i + 1) / parameter_count();
+    if constexpr (K <= 4)
+      return 1 + r;
+    else
+      return 1 + std::cos(r * std::numbers::pi_v<real> / 2);
+  }
+
+  /// Adds the basis function of the linked parameters in '[first, last)'
+  /// divided by their count and the number of subcomponents to the distance
+  /// of objective 'j' for every lane.
+  template <detail::lsmop_basis basis>
+  void subcomponent(auto x,
+                    size_t lanes,
+                    size_t first,
+                    size_t last,
+                    size_t j,
+                    real* g) const {
+    using namespace std;
+    using enum detail::lsmop_basis;
+    constexpr auto pi = numbers::pi_v<real>;
+    const auto n = parameter_count();
+    const auto m = objective_count();
+
+    // Independent accumulators for every lane
+    real s[batch_lanes];
+    real p[batch_lanes];
+    for (size_t l = 0; l < lanes; ++l) {
+      s[l] = 0;
+      p[l] = (basis == griewank) ? 1 : 0;
+    }
+
+    const auto end = (basis == rosenbrock) ? last - 1 : last;
+    for (size_t i = first; i < end; ++i) {
+      const auto a = linkage(i);
+      for (size_t l = 0; l < lanes; ++l) {
+        const real z = a * x[n * l + i] - 10 * x[n * l];
+        if constexpr (basis == sphere)
+          s[l] += z * z;
+        else if constexpr (basis == griewank) {
+          s[l] += z * z / 4000;
+          p[l] *= cos(z / sqrt(real(i - first + 1)));
+        } else if constexpr (basis == schwefel)
+          p[l] = max(p[l], abs(z));
+        else if constexpr (basis == rastrigin)
+          s[l] += z * z - 10 * cos(2 * pi * z) + 10;
+        else if constexpr (basis == rosenbrock) {
+          const real w = linkage(i + 1) * x[n * l + i + 1] - 10 * x[n * l];
+          s[l] += 100 * (z * z - w) * (z * z - w) + (z - 1) * (z - 1);
+        } else {
+          s[l] += z * z;
+          p[l] += cos(2 * pi * z);
+        }
+      }
+    }
+
+    const auto size = real(last - first);
+    for (size_t l = 0; l < lanes; ++l) {
+      real f;
+      if constexpr (basis == griewank)
+        f = s[l] - p[l] + 1;
+      else if constexpr (basis == schwefel)
+        f = p[l];
+      else if constexpr (basis == ackley)
+        f = 20 - 20 * exp(real(-0.2) * sqrt(s[l] / size)) -
+            exp(p[l] / size) + numbers::e_v<real>;
+      else
+        f = s[l];
+      g[m * l + j] += f / size / subcomponents;
+    }
+  }
+
+  /// Parameter indices bounding the subcomponents of all groups
+  std::vector<size_t> bounds{};
+};
+
+template <std::floating_point real, size_t M = dynamic, size_t N = dynamic>
+using lsmop1 = large_scale_problem<real, 1, M, N>;
+template <std::floating_point real, size_t M = dynamic, size_t N = dynamic>
+using lsmop2 = large_scale_problem<real, 2, M, N>;
+template <std::floating_point real, size_t M = dynamic, size_t N = dynamic>
+using lsmop3 = large_scale_problem<real, 3, M, N>;
+template <std::floating_point real, size_t M = dynamic, size_t N = dynamic>
+using lsmop4 = large_scale_problem<real, 4, M, N>;
+template <std::floating_point real, size_t M = dynamic, size_t N = dynamic>
+using lsmop5 = large_scale_problem<real, 5, M, N>;
+template <std::floating_point real, size_t M = dynamic, size_t N = dynamic>
+using lsmop6 = large_scale_problem<real, 6, M, N>;
+template <std::floating_point real, size_t M = dynamic, size_t N = dynamic>
+using lsmop7 = large_scale_problem<real, 7, M, N>;
+template <std::floating_point real, size_t M = dynamic, size_t N = dynamic>
+using lsmop8 = large_scale_problem<real, 8, M, N>;
+template <std::floating_point real, size_t M = dynamic, size_t N = dynamic>
+using lsmop9 = large_scale_problem<real, 9, M, N>;
+
+}  // namespace lyrahgames::pareto::gallery
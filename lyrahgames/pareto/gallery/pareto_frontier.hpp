@@ -0,0 +1,125 @@
+#pragma once
+#include <algorithm>
+#include <concepts>
+#include <numeric>
+#include <span>
+#include <vector>
+//
+#include <lyrahgames/pareto/domination.hpp>
+#include <lyrahgames/pareto/meta.hpp>
+
+namespace lyrahgames::pareto::gallery {
+
+/// Gallery problems whose Pareto set is known analytically provide a member
+/// function mapping the curve parameter 't' in [0, 1] to Pareto-optimal
+/// parameters. For problems with a disconnected frontier, the curve may also
+/// contain weakly dominated points which are filtered afterwards.
+template <typename T>
+concept analytic_problem = generic::problem<T> &&
+    requires(const T& p, typename T::real t, std::span<typename T::real> x) {
+  p.pareto_optimal_parameters(t, x);
+};
+
+/// Scalable gallery problems whose Pareto frontier is known, but not given by
+/// one curve parameter, provide a member function returning about 'count'
+/// samples of their frontier with all objectives stored contiguously. The
+/// samples may contain dominated points which are filtered afterwards.
+template <typename T>
+concept sampled_frontier_problem = generic::problem<T> &&
+    requires(const T& p, size_t count) {
+  {
+    p.pareto_front(count)
+    } -> std::same_as<std::vector<typename T::real>>;
+};
+
+/// Gallery problems that can be used as reference for quality indicators
+template <typename T>
+concept known_frontier_problem =
+    analytic_problem<T> || sampled_frontier_problem<T>;
+
+namespace detail {
+
+/// Returns the non-dominated samples of the 'count' given samples with 'n'
+/// parameters and 'm' objectives inside the given frontier type.
+template <generic::frontier frontier_type>
+auto non_dominated_frontier(size_t count,
+                            size_t n,
+                            size_t m,
+                            std::span<const typename frontier_type::real> x,
+                            std::span<const typename frontier_type::real> y) {
+  using namespace std;
+  const auto f = y.data();
+
+  // Keep non-dominated samples in lexicographic order of their objectives.
+  vector<size_t> order(count);
+  iota(order.begin(), order.end(), 0);
+  sort(order.begin(), order.end(), [&](auto i, auto j) {
+    return lexicographical_compare(&f[m * i], &f[m * (i + 1)], &f[m * j],
+                                   &f[m * (j + 1)]);
+  });
+  vector<size_t> pareto{};
+  for (auto i : order) {
+    const auto v = span{&f[m * i], m};
+    bool dominated = false;
+    if (m == 2) {
+      // Only the last kept point has to be checked in two dimensions.
+      dominated = !pareto.empty() &&
+                  weakly_dominates(span{&f[m * pareto.back()], m}, v);
+    } else {
+      for (auto j : pareto)
+        if (weakly_dominates(span{&f[m * j], m}, v)) {
+          dominated = true;
+          break;
+        }
+    }
+    if (!dominated) pareto.push_back(i);
+  }
+
+  frontier_type frontier{pareto.size(), n, m};
+  for (size_t i = 0; i < pareto.size(); ++i) {
+    copy_n(x.data() + n * pareto[i], n, frontier.parameters_iterator(i));
+    copy_n(&f[m * pareto[i]], m, frontier.objectives_iterator(i));
+  }
+  return frontier;
+}
+
+}  // namespace detail
+
+/// Samples the analytic Pareto frontier of the given problem at 'count' evenly
+/// distributed curve parameters and returns all non-dominated samples inside
+/// the given frontier type. The result can be used as reference frontier for
+/// quality indicators, like the inverted generational distance.
+template <generic::frontier frontier_type>
+auto pareto_frontier(analytic_problem auto problem, size_t count) {
+  using namespace std;
+  using real = typename frontier_type::real;
+  const auto n = problem.parameter_count();
+  const auto m = problem.objective_count();
+
+  vector<real> parameters(n * count);
+  vector<real> objectives(m * count);
+  for (size_t i = 0; i < count; ++i) {
+    const auto t = (count > 1) ? real(i) / (count - 1) : real{0};
+    const auto x = span{&parameters[n * i], n};
+    const auto y = span{&objectives[m * i], m};
+    problem.pareto_optimal_parameters(t, x);
+    problem.evaluate(x, y);
+  }
+  return detail::non_dominated_frontier<frontier_type>(
+      count, n, m, parameters, objectives);
+}
+
+/// Returns the non-dominated samples of the sampled Pareto frontier of the
+/// given problem inside the given frontier type. Only objectives are known
+/// such that the frontier stores no parameters.
+template <generic::frontier frontier_type>
+auto pareto_frontier(sampled_frontier_problem auto problem, size_t count) {
+  using real = typename frontier_type::real;
+  const auto m = problem.objective_count();
+  const auto front = problem.pareto_front(count);
+  const std::vector<real> objectives(front.begin(), front.end());
+  return detail::non_dominated_frontier<frontier_type>(
+      objectives.size() / m, 0, m, {}, objectives);
+}
+
+}  // namespace lyrahgames::pareto::gallery
@@ -0,0 +1,170 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <numbers>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <vector>
+//
+#include <lyrahgames/pareto/meta.hpp>
+#include <lyrahgames/pareto/reference_points.hpp>
+
+namespace lyrahgames::pareto::gallery {
+
+/// Marks parameter and objective counts of scalable problems that are given
+/// at runtime instead of compile time.
+inline constexpr size_t dynamic = 0;
+
+/// Number of samples whose distance functions are computed together by the
+/// batch evaluation of scalable problems. The innermost loops run over these
+/// samples with independent accumulators such that they can be vectorized
+/// and are not bound by the latency of one long sum.
+inline constexpr size_t batch_lanes = 16;
+
+/// Base of problem families that scale in the number of objectives and
+/// parameters. Counts given as template arguments are compile-time constants
+/// such that loops over them can be unrolled. Otherwise, they are given to
+/// the constructor at runtime. Derived problems split their evaluation into
+/// two steps. First, 'distances(x, lanes, g)' computes 'distance_count()'
+/// values, like the distance function, for each of 'lanes' samples stored
+/// contiguously at 'x' and stores them lane after lane at 'g'. Afterwards,
+/// 'shape(x, g, y)' computes the objectives of one sample from its parameters
+/// and values.
+template <std::floating_point T, size_t M, size_t N>
+class scalable_problem {
+ public:
+  using real = T;
+
+  constexpr size_t objective_count() const noexcept {
+    if constexpr (M == dynamic)
+      return m;
+    else
+      return M;
+  }
+
+  constexpr size_t parameter_count() const noexcept {
+    if constexpr (N == dynamic)
+      return n;
+    else
+      return N;
+  }
+
+ protected:
+  scalable_problem(size_t objectives, size_t parameters)
+      : m{objectives}, n{parameters} {
+    if ((M != dynamic) && (m != M))
+      throw std::invalid_argument(
+          "Objective count does not match the compile-time objective count.");
+    if ((N != dynamic) && (n != N))
+      throw std::invalid_argument(
+          "Parameter count does not match the compile-time parameter count.");
+    if (m < 2)
+      throw std::invalid_argument("Problem needs at least two objectives.");
+    if (n < m)
+      throw std::invalid_argument(
+          "Problem needs at least as many parameters as objectives.");
+  }
+
+ private:
+  size_t m;
+  size_t n;
+};
+
+namespace detail {
+
+/// Evaluates one sample of a scalable problem as a single lane.
+template <typename problem_type>
+void evaluate_sample(const problem_type& problem, const auto& x, auto&& y) {
+  using real = typename problem_type::real;
+  thread_local std::vector<real> g{};
+  g.resize(problem.distance_count());
+  problem.distances(std::ranges::begin(x), 1, g.data());
+  problem.shape(std::ranges::begin(x), g.data(), std::ranges::begin(y));
+}
+
+/// Evaluates contiguously stored samples of a scalable problem in blocks of
+/// 'batch_lanes' samples.
+template <typename problem_type, typename real>
+void evaluate_samples(const problem_type& problem,
+                      std::span<const real> x,
+                      std::span<real> y) {
+  const auto n = problem.parameter_count();
+  const auto m = problem.objective_count();
+  const auto w = problem.distance_count();
+  const auto count = x.size() / n;
+  std::vector<real> g(batch_lanes * w);
+  for (size_t i = 0; i < count; i += batch_lanes) {
+    const auto lanes = std::min(batch_lanes, count - i);
+    problem.distances(&x[n * i], lanes, g.data());
+    for (size_t l = 0; l < lanes; ++l)
+      problem.shape(&x[n * (i + l)], &g[w * l], &y[m * (i + l)]);
+  }
+}
+
+/// Samples the linear frontier whose objectives sum up to 'scale'.
+template <generic::real real>
+auto linear_front(size_t m, size_t count, real scale) {
+  auto result = simplex_lattice<real>(m, simplex_divisions(m, count));
+  for (auto& y : result)
+    y *= scale;
+  return result;
+}
+
+/// Samples the spherical frontier whose objectives divided by their scales
+/// lie on the unit sphere. Scales are given by 'scale(j)'.
+template <generic::real real>
+auto spherical_front(size_t m, size_t count, auto&& scale) {
+  auto result = simplex_lattice<real>(m, simplex_divisions(m, count));
+  for (size_t i = 0; i < result.size(); i += m) {
+    real norm = 0;
+    for (size_t j = 0; j < m; ++j)
+      norm += result[i + j] * result[i + j];
+    norm = std::sqrt(norm);
+    for (size_t j = 0; j < m; ++j)
+      result[i + j] *= scale(j) / norm;
+  }
+  return result;
+}
+
+/// Samples the regular grid in the unit cube of the given dimension with
+/// about 'count' points and calls 'f(t)' for every point 't'.
+template <generic::real real>
+void for_each_grid_point(size_t dimension, size_t count, auto&& f) {
+  const auto root = 1.0 / double(std::max<size_t>(dimension, 1));
+  const auto steps = std::max<size_t>(2, size_t(std::pow(double(count), root)));
+  std::vector<size_t> index(dimension, 0);
+  std::vector<real> t(dimension, 0);
+  while (true) {
+    for (size_t j = 0; j < dimension; ++j)
+      t[j] = real(index[j]) / (steps - 1);
+    f(std::span<const real>{t});
+    size_t j = 0;
+    for (; j < dimension && ++index[j] == steps; ++j)
+      index[j] = 0;
+    if (j == dimension) break;
+  }
+}
+
+/// Samples the disconnected frontier of DTLZ7 and LSMOP9 whose last
+/// objective is given by the other ones and the minimal distance 'g'. The
+/// result contains dominated points that have to be filtered.
+template <generic::real real>
+auto disconnected_front(size_t m, size_t count, real g) {
+  using namespace std;
+  vector<real> result{};
+  for_each_grid_point<real>(m - 1, count, [&](span<const real> t) {
+    real h = m;
+    for (size_t j = 0; j < m - 1; ++j) {
+      result.push_back(t[j]);
+      h -= t[j] / (1 + g) * (1 + sin(3 * numbers::pi_v<real> * t[j]));
+    }
+    result.push_back((1 + g) * h);
+  });
+  return result;
+}
+
+}  // namespace detail
+
+}  // namespace lyrahgames::pareto::gallery
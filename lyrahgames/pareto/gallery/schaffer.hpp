@@ -37,6 +37,12 @@ struct schaffer_1_problem {
     y[1] = square(x[0] - 2);
   }
 
+  /// Maps the curve parameter 't' in [0, 1] to Pareto-optimal parameters.
+  void pareto_optimal_parameters(real t, generic::range<real> auto&& x) const {
+    assert(std::ranges::size(x) == parameter_count());
+    x[0] = 2 * t;
+  }
+
   real a;
 };
 
@@ -66,6 +72,13 @@ struct schaffer_2_problem {
                               : ((x[0] <= 4) ? (4 - x[0]) : (x[0] - 4)));
     y[1] = square(x[0] - 5);
   }
+
+  /// Maps the curve parameter 't' in [0, 1] to Pareto-optimal parameters.
+  /// The Pareto set consists of the two intervals [1, 2] and [4, 5].
+  void pareto_optimal_parameters(real t, generic::range<real> auto&& x) const {
+    assert(std::ranges::size(x) == parameter_count());
+    x[0] = (t < real(0.5)) ? (1 + 2 * t) : (3 + 2 * t);
+  }
 };
 
 template <std::floating_point real>
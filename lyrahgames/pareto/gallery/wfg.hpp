@@ -0,0 +1,408 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <numbers>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <vector>
+//
+#include <lyrahgames/pareto/meta.hpp>
+//
+#include <lyrahgames/pareto/gallery/scalable.hpp>
+
+namespace lyrahgames::pareto::gallery {
+
+namespace detail {
+
+// Transformation functions of the WFG toolkit of Huband et al. Their results
+// are clamped to the unit interval to remove rounding errors.
+
+template <generic::real real>
+inline real b_poly(real y, real a) {
+  return std::clamp(std::pow(y, a), real(0), real(1));
+}
+
+template <generic::real real>
+inline real b_flat(real y, real a, real b, real c) {
+  using namespace std;
+  const auto result = a + min(real(0), floor(y - b)) * a * (b - y) / b -
+                      min(real(0), floor(c - y)) * (1 - a) * (y - c) / (1 - c);
+  return clamp(result, real(0), real(1));
+}
+
+/// Exponent of the parameter-dependent bias 'b_param' for the given value
+/// 'u' of the other parameters
+template <generic::real real>
+inline real b_param_exponent(real u, real a, real b, real c) {
+  using namespace std;
+  return b + (c - b) * (a - (1 - 2 * u) * abs(floor(real(0.5) - u) + a));
+}
+
+template <generic::real real>
+inline real b_param(real y, real u, real a, real b, real c) {
+  return std::clamp(std::pow(y, b_param_exponent(u, a, b, c)), real(0),
+                    real(1));
+}
+
+template <generic::real real>
+inline real s_linear(real y, real a) {
+  using namespace std;
+  return clamp(abs(y - a) / abs(floor(a - y) + a), real(0), real(1));
+}
+
+template <generic::real real>
+inline real s_decept(real y, real a, real b, real c) {
+  using namespace std;
+  const auto result =
+      1 + (abs(y - a) - b) *
+              (floor(y - a + b) * (1 - c + (a - b) / b) / (a - b) +
+               floor(a + b - y) * (1 - c + (1 - a - b) / b) / (1 - a - b) +
+               1 / b);
+  return clamp(result, real(0), real(1));
+}
+
+template <generic::real real>
+inline real s_multi(real y, real a, real b, real c) {
+  using namespace std;
+  constexpr auto pi = numbers::pi_v<real>;
+  const auto d = abs(y - c) / (2 * (floor(c - y) + c));
+  const auto result = (1 + cos((4 * a + 2) * pi * (real(0.5) - d)) +
+                       4 * b * d * d) /
+                      (b + 2);
+  return clamp(result, real(0), real(1));
+}
+
+/// Weighted sum reduction of 'count' values at 'y'. The weight of value 'i'
+/// is 'i + 1 + offset' or one if the sum is not weighted.
+template <generic::real real>
+inline real r_sum(const real* y, size_t count, size_t offset, bool weighted) {
+  real sum = 0;
+  real weights = 0;
+  for (size_t i = 0; i < count; ++i) {
+    const auto w = weighted ? real(2 * (i + 1 + offset)) : real(1);
+    sum += w * y[i];
+    weights += w;
+  }
+  return std::clamp(sum / weights, real(0), real(1));
+}
+
+/// Non-separable reduction of 'count' values at 'y' with degree 'a'
+template <generic::real real>
+inline real r_nonsep(const real* y, size_t count, size_t a) {
+  using namespace std;
+  real sum = 0;
+  for (size_t j = 0; j < count; ++j) {
+    sum += y[j];
+    for (size_t k = 0; k + 2 <= a; ++k)
+      sum += abs(y[j] - y[(j + k + 1) % count]);
+  }
+  const auto half = (a + 1) / 2;
+  const auto denominator = real(count) / a * half * (1 + 2 * a - 2 * half);
+  return clamp(sum / denominator, real(0), real(1));
+}
+
+}  // namespace detail
+
+/// Scalable test problems WFG1 to WFG9 of the Walking Fish Group selected by
+/// 'K'. The first 'k' position parameters, a multiple of 'm - 1', determine
+/// the position on the Pareto frontier and the remaining ones its distance.
+/// Parameter 'i' is defined on the interval [0, 2(i + 1)].
+template <std::floating_point T,
+          size_t K,
+          size_t M = dynamic,
+          size_t N = dynamic>
+class walking_fish_group_problem : public scalable_problem<T, M, N> {
+  static_assert((1 <= K) && (K <= 9), "There are only nine WFG problems.");
+  using base = scalable_problem<T, M, N>;
+
+ public:
+  using real = T;
+  using base::objective_count;
+  using base::parameter_count;
+
+  /// Number of distance parameters used if no parameter count is given
+  static constexpr size_t distance_parameters = 20;
+
+  /// If no position count is given, it is set to '2 (m - 1)'.
+  explicit walking_fish_group_problem(
+      size_t objectives = (M != dynamic) ? M : 3,
+      size_t parameters = N,
+      size_t positions = 0)
+      : base(objectives,
+             parameters ? parameters
+                        : (positions ? positions : 2 * (objectives - 1)) +
+                              distance_parameters),
+        k{positions ? positions : 2 * (objectives - 1)} {
+    const auto m = objective_count();
+    const auto n = parameter_count();
+    if ((k == 0) || (k % (m - 1) != 0))
+      throw std::invalid_argument(
+          "Position count has to be a positive multiple of the objective "
+          "count minus one.");
+    if (k >= n)
+      throw std::invalid_argument(
+          "There has to be at least one distance parameter.");
+    if (((K == 2) || (K == 3)) && ((n - k) % 2 != 0))
+      throw std::invalid_argument(
+          "Distance count of WFG2 and WFG3 has to be even.");
+  }
+
+  static constexpr real box_min(size_t index) { return 0; }
+  static constexpr real box_max(size_t index) { return 2 * real(index + 1); }
+
+  /// Returns the number of position parameters.
+  size_t position_count() const noexcept { return k; }
+
+  void evaluate(const generic::range<real> auto& x,
+                generic::range<real> auto&& y) const {
+    assert(std::ranges::size(x) == parameter_count());
+    assert(std::ranges::size(y) == objective_count());
+    detail::evaluate_sample(*this, x, y);
+  }
+
+  /// Evaluates contiguously stored samples. The transformations are
+  /// sequential for every sample such that samples are evaluated one by one.
+  void evaluate_batch(std::span<const real> x, std::span<real> y) const {
+    detail::evaluate_samples(*this, x, y);
+  }
+
+  /// The transformed position and distance values are passed to the shape.
+  size_t distance_count() const noexcept { return objective_count(); }
+
+  void distances(auto x, size_t lanes, real* t) const {
+    const auto n = parameter_count();
+    for (size_t l = 0; l < lanes; ++l)
+      transform(x + n * l, t + objective_count() * l);
+  }
+
+  void shape(auto, const real* t, auto y) const {
+    using namespace std;
+    constexpr auto pi = numbers::pi_v<real>;
+    const auto m = objective_count();
+    const auto distance = t[m - 1];
+    // Degenerate parameters of WFG3 collapse the frontier to a line.
+    const auto position = [&](size_t j) {
+      const auto a = ((K == 3) && (j > 0)) ? real(0) : real(1);
+      return max(distance, a) * (t[j] - real(0.5)) + real(0.5);
+    };
+
+    real p = 1;
+    for (size_t r = 0; r < m - 1; ++r) {
+      const auto v = position(r);
+      if constexpr ((K == 1) || (K == 2)) {
+        y[m - 1 - r] = p * (1 - sin(v * pi / 2));
+        p *= 1 - cos(v * pi / 2);
+      } else if constexpr (K == 3) {
+        y[m - 1 - r] = p * (1 - v);
+        p *= v;
+      } else {
+        y[m - 1 - r] = p * cos(v * pi / 2);
+        p *= sin(v * pi / 2);
+      }
+    }
+    y[0] = p;
+
+    const auto v = position(0);
+    if constexpr (K == 1)
+      y[m - 1] = 1 - v - cos(10 * pi * v + pi / 2) / (10 * pi);
+    else if constexpr (K == 2)
+      y[m - 1] = 1 - v * pow(cos(5 * v * pi), 2);
+
+    for (size_t j = 0; j < m; ++j)
+      y[j] = distance + 2 * real(j + 1) * y[j];
+  }
+
+  /// Maps the position 't' in the unit cube with 'm - 1' dimensions to
+  /// Pareto-optimal parameters. All position parameters of one group are set
+  /// to the same value. For WFG1 and WFG7, their bias is inverted such that
+  /// the reduced positions equal 't'. Distance parameters are chosen such
+  /// that their transformed values vanish.
+  void pareto_optimal_parameters(const generic::range<real> auto& t,
+                                 generic::range<real> auto&& x) const {
+    using namespace std;
+    assert(ranges::size(x) == parameter_count());
+    const auto m = objective_count();
+    const auto n = parameter_count();
+    const auto group = k / (m - 1);
+    constexpr auto a = real(0.98 / 49.98);
+    constexpr auto b = real(0.02);
+    constexpr auto c = real(50);
+    constexpr auto optimum = real(0.35);
+
+    vector<real> y(n);
+    for (size_t i = 0; i < k; ++i)
+      y[i] = (K == 1) ? pow(real(t[i / group]), real(50)) : real(t[i / group]);
+    for (size_t i = k; i < n; ++i)
+      y[i] = optimum;
+
+    if constexpr (K == 7) {
+      real suffix = (n - k) * optimum;
+      for (size_t i = k; i-- > 0;) {
+        const auto u = suffix / (n - 1 - i);
+        y[i] = pow(y[i], 1 / detail::b_param_exponent(u, a, b, c));
+        suffix += y[i];
+      }
+    } else if constexpr (K == 8) {
+      real prefix = 0;
+      for (size_t i = 0; i < k; ++i)
+        prefix += y[i];
+      for (size_t i = k; i < n; ++i) {
+        const auto u = prefix / i;
+        y[i] = pow(optimum, 1 / detail::b_param_exponent(u, a, b, c));
+        prefix += y[i];
+      }
+    } else if constexpr (K == 9) {
+      real suffix = y[n - 1];
+      for (size_t i = n - 1; i-- > k;) {
+        const auto u = suffix / (n - 1 - i);
+        y[i] = pow(optimum, 1 / detail::b_param_exponent(u, a, b, c));
+        suffix += y[i];
+      }
+    }
+
+    for (size_t i = 0; i < n; ++i)
+      x[i] = clamp(2 * real(i + 1) * y[i], real(0), box_max(i));
+  }
+
+  /// Returns about 'count' samples of the Pareto frontier with 'm' objectives
+  /// per sample. The disconnected frontier of WFG2 contains dominated
+  /// samples.
+  auto pareto_front(size_t count) const {
+    using namespace std;
+    const auto m = objective_count();
+    if constexpr ((K == 1) || (K == 2)) {
+      vector<real> result{};
+      vector<real> t(m, 0);
+      detail::for_each_grid_point<real>(m - 1, count, [&](span<const real> s) {
+        copy(s.begin(), s.end(), t.begin());
+        const auto first = result.size();
+        result.resize(first + m);
+        shape(nullptr, t.data(), &result[first]);
+      });
+      return result;
+    } else if constexpr (K == 3) {
+      vector<real> result(m * count);
+      vector<real> t(m, 0);
+      for (size_t i = 0; i < count; ++i) {
+        t[0] = (count > 1) ? real(i) / (count - 1) : real(0);
+        shape(nullptr, t.data(), &result[m * i]);
+      }
+      return result;
+    } else
+      return detail::spherical_front<real>(
+          m, count, [](size_t j) { return 2 * real(j + 1); });
+  }
+
+ private:
+  /// Normalizes and transforms the parameters of one sample and reduces them
+  /// to 'm' values.
+  void transform(auto x, real* t) const {
+    using namespace std;
+    using namespace detail;
+    const auto m = objective_count();
+    const auto n = parameter_count();
+    const auto l = n - k;
+    const auto group = k / (m - 1);
+    constexpr auto a = real(0.98 / 49.98);
+    constexpr auto b = real(0.02);
+    constexpr auto c = real(50);
+    constexpr auto optimum = real(0.35);
+
+    thread_local vector<real> buffer{};
+    buffer.resize(n);
+    const auto y = buffer.data();
+    for (size_t i = 0; i < n; ++i)
+      y[i] = x[i] / (2 * real(i + 1));
+
+    if constexpr (K == 1) {
+      for (size_t i = k; i < n; ++i)
+        y[i] = b_flat(s_linear(y[i], optimum), real(0.8), real(0.75),
+                      real(0.85));
+      for (size_t i = 0; i < n; ++i)
+        y[i] = b_poly(y[i], real(0.02));
+    } else if constexpr ((K == 2) || (K == 3)) {
+      for (size_t i = k; i < n; ++i)
+        y[i] = s_linear(y[i], optimum);
+      for (size_t i = 0; i < l / 2; ++i)
+        y[k + i] = r_nonsep(y + k + 2 * i, 2, 2);
+    } else if constexpr (K == 4) {
+      for (size_t i = 0; i < n; ++i)
+        y[i] = s_multi(y[i], real(30), real(10), optimum);
+    } else if constexpr (K == 5) {
+      for (size_t i = 0; i < n; ++i)
+        y[i] = s_decept(y[i], optimum, real(0.001), real(0.05));
+    } else if constexpr (K == 6) {
+      for (size_t i = k; i < n; ++i)
+        y[i] = s_linear(y[i], optimum);
+    } else if constexpr (K == 7) {
+      real suffix = 0;
+      for (size_t i = n; i-- > k;)
+        suffix += y[i];
+      for (size_t i = k; i-- > 0;) {
+        const auto value = y[i];
+        y[i] = b_param(value, suffix / (n - 1 - i), a, b, c);
+        suffix += value;
+      }
+      for (size_t i = k; i < n; ++i)
+        y[i] = s_linear(y[i], optimum);
+    } else if constexpr (K == 8) {
+      real prefix = 0;
+      for (size_t i = 0; i < k; ++i)
+        prefix += y[i];
+      for (size_t i = k; i < n; ++i) {
+        const auto value = y[i];
+        y[i] = s_linear(b_param(value, prefix / i, a, b, c), optimum);
+        prefix += value;
+      }
+    } else if constexpr (K == 9) {
+      real suffix = y[n - 1];
+      for (size_t i = n - 1; i-- > 0;) {
+        const auto value = y[i];
+        y[i] = b_param(value, suffix / (n - 1 - i), a, b, c);
+        suffix += value;
+      }
+      for (size_t i = 0; i < k; ++i)
+        y[i] = s_decept(y[i], optimum, real(0.001), real(0.05));
+      for (size_t i = k; i < n; ++i)
+        y[i] = s_multi(y[i], real(30), real(95), optimum);
+    }
+
+    const auto distances = ((K == 2) || (K == 3)) ? l / 2 : l;
+    for (size_t j = 0; j < m - 1; ++j) {
+      if constexpr ((K == 6) || (K == 9))
+        t[j] = r_nonsep(y + j * group, group, group);
+      else
+        t[j] = r_sum(y + j * group, group, j * group, K == 1);
+    }
+    if constexpr ((K == 6) || (K == 9))
+      t[m - 1] = r_nonsep(y + k, distances, distances);
+    else
+      t[m - 1] = r_sum(y + k, distances, k, K == 1);
+  }
+
+  size_t k;
+};
+
+template <std::floating_point real, size_t M = dynamic, size_t N = dynamic>
+using wfg1 = walking_fish_group_problem<real, 1, M, N>;
+template <std::floating_point real, size_t M = dynamic, size_t N = dynamic>
+using wfg2 = walking_fish_group_problem<real, 2, M, N>;
+template <std::floating_point real, size_t M = dynamic, size_t N = dynamic>
+using wfg3 = walking_fish_group_problem<real, 3, M, N>;
+template <std::floating_point real, size_t M = dynamic, size_t N = dynamic>
+using wfg4 = walking_fish_group_problem<real, 4, M, N>;
+template <std::floating_point real, size_t M = dynamic, size_t N = dynamic>
+using wfg5 = walking_fish_group_problem<real, 5, M, N>;
+template <std::floating_point real, size_t M = dynamic, size_t N = dynamic>
+using wfg6 = walking_fish_group_problem<real, 6, M, N>;
+template <std::floating_point real, size_t M = dynamic, size_t N = dynamic>
+using wfg7 = walking_fish_group_problem<real, 7, M, N>;
+template <std::floating_point real, size_t M = dynamic, size_t N = dynamic>
+using wfg8 = walking_fish_group_problem<real, 8, M, N>;
+template <std::floating_point real, size_t M = dynamic, size_t N = dynamic>
+using wfg9 = walking_fish_group_problem<real, 9, M, N>;
+
+}  // namespace lyrahgames::pareto::gallery
@@ -35,6 +35,34 @@ struct zitzler_deb_thiele_1_problem {
     y[0] = x[0];
     y[1] = h * g;
   }
+
+  /// Updates the objectives of the parent for changes of the given
+  /// parameters. The function 'g' of the parent is recovered from its
+  /// objectives and only changed by the differences of changed parameters.
+  void evaluate_delta(const generic::range<real> auto& parent_x,
+                      const generic::range<real> auto& parent_y,
+                      const std::ranges::input_range auto& changed,
+                      const generic::range<real> auto& x,
+                      generic::range<real> auto&& y) const {
+    using namespace std;
+    // Solve y[1] = g - sqrt(x[0] g) for the square root of g.
+    const auto a = parent_x[0];
+    const auto u = (sqrt(a) + sqrt(a + 4 * parent_y[1])) / 2;
+    real g = u * u;
+    for (auto i : changed)
+      if (i > 0) g += 9 * (x[i] - parent_x[i]) / 29;
+
+    y[0] = x[0];
+    y[1] = (1 - sqrt(x[0] / g)) * g;
+  }
+
+  /// Maps the curve parameter 't' in [0, 1] to Pareto-optimal parameters.
+  void pareto_optimal_parameters(real t, generic::range<real> auto&& x) const {
+    assert(std::ranges::size(x) == parameter_count());
+    x[0] = t;
+    for (size_t i = 1; i < parameter_count(); ++i)
+      x[i] = 0;
+  }
 };
 
 template <std::floating_point real>
@@ -67,6 +95,33 @@ struct zitzler_deb_thiele_2_problem {
     y[0] = x[0];
     y[1] = h * g;
   }
+
+  /// Updates the objectives of the parent for changes of the given
+  /// parameters. See 'zitzler_deb_thiele_1_problem::evaluate_delta'.
+  void evaluate_delta(const generic::range<real> auto& parent_x,
+                      const generic::range<real> auto& parent_y,
+                      const std::ranges::input_range auto& changed,
+                      const generic::range<real> auto& x,
+                      generic::range<real> auto&& y) const {
+    using namespace std;
+    const auto square = [](real x) { return x * x; };
+    // Solve y[1] = g - x[0]^2 / g for g.
+    const auto b = parent_y[1];
+    real g = (b + sqrt(b * b + 4 * square(parent_x[0]))) / 2;
+    for (auto i : changed)
+      if (i > 0) g += 9 * (x[i] - parent_x[i]) / 29;
+
+    y[0] = x[0];
+    y[1] = (1 - square(x[0] / g)) * g;
+  }
+
+  /// Maps the curve parameter 't' in [0, 1] to Pareto-optimal parameters.
+  void pareto_optimal_parameters(real t, generic::range<real> auto&& x) const {
+    assert(std::ranges::size(x) == parameter_count());
+    x[0] = t;
+    for (size_t i = 1; i < parameter_count(); ++i)
+      x[i] = 0;
+  }
 };
 
 template <std::floating_point real>
@@ -99,6 +154,37 @@ struct zitzler_deb_thiele_3_problem {
     y[0] = x[0];
     y[1] = h * g;
   }
+
+  /// Updates the objectives of the parent for changes of the given
+  /// parameters. See 'zitzler_deb_thiele_1_problem::evaluate_delta'.
+  void evaluate_delta(const generic::range<real> auto& parent_x,
+                      const generic::range<real> auto& parent_y,
+                      const std::ranges::input_range auto& changed,
+                      const generic::range<real> auto& x,
+                      generic::range<real> auto&& y) const {
+    using namespace std;
+    // Solve y[1] = g - sqrt(x[0] g) - x[0] sin(10 pi x[0]) for sqrt(g).
+    const auto a = parent_x[0];
+    const auto c = parent_y[1] + a * sin(10 * M_PI * a);
+    const auto u = (sqrt(a) + sqrt(a + 4 * c)) / 2;
+    real g = u * u;
+    for (auto i : changed)
+      if (i > 0) g += 9 * (x[i] - parent_x[i]) / 29;
+
+    real h = x[0] / g;
+    h = 1 - sqrt(h) - h * sin(10 * M_PI * x[0]);
+
+    y[0] = x[0];
+    y[1] = h * g;
+  }
+
+  /// Maps the curve parameter 't' in [0, 1] to Pareto-optimal parameters.
+  void pareto_optimal_parameters(real t, generic::range<real> auto&& x) const {
+    assert(std::ranges::size(x) == parameter_count());
+    x[0] = t;
+    for (size_t i = 1; i < parameter_count(); ++i)
+      x[i] = 0;
+  }
 };
 
 template <std::floating_point real>
@@ -137,6 +223,36 @@ struct zitzler_deb_thiele_4_problem {
     y[0] = x[0];
     y[1] = h * g;
   }
+
+  /// Updates the objectives of the parent for changes of the given
+  /// parameters. See 'zitzler_deb_thiele_1_problem::evaluate_delta'.
+  void evaluate_delta(const generic::range<real> auto& parent_x,
+                      const generic::range<real> auto& parent_y,
+                      const std::ranges::input_range auto& changed,
+                      const generic::range<real> auto& x,
+                      generic::range<real> auto&& y) const {
+    using namespace std;
+    constexpr auto pi = std::numbers::pi_v<real>;
+    const auto term = [](real x) { return x * x - 10 * cos(4 * pi * x); };
+
+    // Solve y[1] = g - sqrt(x[0] g) for the square root of g.
+    const auto a = parent_x[0];
+    const auto u = (sqrt(a) + sqrt(a + 4 * parent_y[1])) / 2;
+    real g = u * u;
+    for (auto i : changed)
+      if (i > 0) g += term(x[i]) - term(parent_x[i]);
+
+    y[0] = x[0];
+    y[1] = (1 - sqrt(x[0] / g)) * g;
+  }
+
+  /// Maps the curve parameter 't' in [0, 1] to Pareto-optimal parameters.
+  void pareto_optimal_parameters(real t, generic::range<real> auto&& x) const {
+    assert(std::ranges::size(x) == parameter_count());
+    x[0] = t;
+    for (size_t i = 1; i < parameter_count(); ++i)
+      x[i] = 0;
+  }
 };
 
 template <std::floating_point real>
@@ -173,6 +289,40 @@ struct zitzler_deb_thiele_6_problem {
     y[0] = f;
     y[1] = h * g;
   }
+
+  /// Updates the objectives of the parent for changes of the given
+  /// parameters. The sum inside of 'g' is recovered from the objectives of
+  /// the parent. See 'zitzler_deb_thiele_1_problem::evaluate_delta'.
+  void evaluate_delta(const generic::range<real> auto& parent_x,
+                      const generic::range<real> auto& parent_y,
+                      const std::ranges::input_range auto& changed,
+                      const generic::range<real> auto& x,
+                      generic::range<real> auto&& y) const {
+    using namespace std;
+    constexpr auto pi = std::numbers::pi_v<real>;
+    const auto square = [](real x) { return x * x; };
+
+    // Solve y[1] = g - y[0]^2 / g for g and invert g = 1 + 9 (sum / 9)^0.25.
+    const auto b = parent_y[1];
+    const auto g = (b + sqrt(b * b + 4 * square(parent_y[0]))) / 2;
+    real sum = 9 * square(square((g - 1) / 9));
+    for (auto i : changed)
+      if (i > 0) sum += x[i] - parent_x[i];
+    const auto gx = 1 + 9 * pow(max(sum, real{0}) / 9, real{0.25});
+
+    const auto f = 1 - exp(-4 * x[0]) * pow(sin(6 * pi * x[0]), 6);
+
+    y[0] = f;
+    y[1] = (1 - square(f / gx)) * gx;
+  }
+
+  /// Maps the curve parameter 't' in [0, 1] to Pareto-optimal parameters.
+  void pareto_optimal_parameters(real t, generic::range<real> auto&& x) const {
+    assert(std::ranges::size(x) == parameter_count());
+    x[0] = t;
+    for (size_t i = 1; i < parameter_count(); ++i)
+      x[i] = 0;
+  }
 };
 
 template <std::floating_point real>
@@ -0,0 +1,635 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <map>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+//
+#include <lyrahgames/pareto/domination.hpp>
+#include <lyrahgames/pareto/meta.hpp>
+#include <lyrahgames/pareto/parallel.hpp>
+
+namespace lyrahgames::pareto {
+
+namespace detail {
+
+/// Copies all points of the given frontier that strictly dominate the
+/// reference point into a contiguous array with 'm' values per point. All
+/// other points cannot contribute to the hypervolume.
+template <generic::frontier frontier_type>
+auto hypervolume_points(const frontier_type& frontier,
+                        std::span<const typename frontier_type::real> r) {
+  using real = typename frontier_type::real;
+  const auto m = frontier.objective_count();
+  std::vector<real> points{};
+  points.reserve(m * frontier.sample_count());
+  for (size_t i = 0; i < frontier.sample_count(); ++i) {
+    auto it = frontier.objectives_iterator(i);
+    bool inside = true;
+    for (size_t j = 0; j < m; ++j, ++it)
+      inside = inside && (*it < r[j]);
+    if (!inside) continue;
+    points.insert(points.end(), frontier.objectives_iterator(i),
+                  frontier.objectives_iterator(i) + m);
+  }
+  return points;
+}
+
+/// Removes all weakly dominated and duplicated points from the given
+/// contiguous point array with 'm' values per point in place and returns the
+/// number of remaining points.
+template <generic::real real>
+size_t remove_weakly_dominated(std::vector<real>& points, size_t m) {
+  using namespace std;
+  const auto count = points.size() / m;
+  size_t front = 0;
+  for (size_t i = 0; i < count; ++i) {
+    const auto p = span{&points[m * i], m};
+    bool dominated = false;
+    for (size_t j = 0; j < front;) {
+      const auto q = span{&points[m * j], m};
+      if (weakly_dominates(q, p)) {
+        dominated = true;
+        break;
+      }
+      // Replace points that are dominated by the last kept point.
+      if (dominates(p, q)) {
+        --front;
+        copy_n(&points[m * front], m, &points[m * j]);
+      } else {
+        ++j;
+      }
+    }
+    if (dominated) continue;
+    if (front != i) copy_n(&points[m * i], m, &points[m * front]);
+    ++front;
+  }
+  points.resize(m * front);
+  return front;
+}
+
+/// Computes the two-dimensional hypervolume of 'count' points with 'stride'
+/// values per point with respect to the reference point 'r' by a sweep over
+/// the first objective. The points are reordered. Complexity: O(n log n)
+template <generic::real real>
+real hypervolume_2d(real* points, size_t count, size_t stride, const real* r) {
+  using namespace std;
+  vector<size_t> order(count);
+  iota(order.begin(), order.end(), 0);
+  sort(order.begin(), order.end(), [&](auto i, auto j) {
+    return points[stride * i] < points[stride * j];
+  });
+  real result = 0;
+  real bound = r[1];
+  for (auto i : order) {
+    const auto y = points[stride * i + 1];
+    if (y >= bound) continue;
+    result += (r[0] - points[stride * i]) * (bound - y);
+    bound = y;
+  }
+  return result;
+}
+
+/// Computes the three-dimensional hypervolume of 'count' points with 'stride'
+/// values per point with respect to the reference point 'r'. The points are
+/// swept along the third objective while the non-dominated staircase of the
+/// first two objectives and its area are maintained in a balanced tree.
+/// Complexity: O(n log n)
+template <generic::real real>
+real hypervolume_3d(real* points, size_t count, size_t stride, const real* r) {
+  using namespace std;
+  vector<size_t> order(count);
+  iota(order.begin(), order.end(), 0);
+  sort(order.begin(), order.end(), [&](auto i, auto j) {
+    return points[stride * i + 2] < points[stride * j + 2];
+  });
+
+  // The staircase maps the first objective to the second objective. Keys are
+  // increasing while values are strictly decreasing.
+  map<real, real> staircase{};
+  real area = 0;
+  real volume = 0;
+  real z = (count > 0) ? points[stride * order[0] + 2] : r[2];
+
+  for (auto i : order) {
+    const auto x = points[stride * i + 0];
+    const auto y = points[stride * i + 1];
+    volume += area * (points[stride * i + 2] - z);
+    z = points[stride * i + 2];
+
+    // Skip points that are dominated in the first two objectives.
+    auto it = staircase.upper_bound(x);
+    if (it != staircase.begin() && prev(it)->second <= y) continue;
+
+    // Start with the height of the staircase directly left of the new point.
+    it = staircase.lower_bound(x);
+    real height =
+        (it == staircase.begin()) ? real{0} : r[1] - prev(it)->second;
+    real position = x;
+
+    // Remove all points dominated by the new point and update the area.
+    while (it != staircase.end() && it->second >= y) {
+      area -= (it->first - position) * height;
+      position = it->first;
+      height = r[1] - it->second;
+      it = staircase.erase(it);
+    }
+    const auto next = (it == staircase.end()) ? r[0] : it->first;
+    area -= (next - position) * height;
+    area += (next - x) * (r[1] - y);
+    staircase.emplace(x, y);
+  }
+  volume += area * (r[2] - z);
+  return volume;
+}
+
+/// Exact hypervolume computation for an arbitrary number of objectives in the
+/// style of the WFG algorithm. Points are sorted in descending order with
+/// respect to their last objective. Hence, the limit set of every point with
+/// respect to all following points has a constant last objective and the
+/// exclusive hypervolume can be computed in one dimension less. Scratch memory
+/// is kept per recursion level to not allocate inside of the recursion.
+template <generic::real real>
+class wfg {
+ public:
+  /// Computes the hypervolume of 'count' non-dominated points with 'dim'
+  /// values per point with respect to the reference point 'r'. The points are
+  /// reordered.
+  real hypervolume(real* points, size_t count, size_t dim, const real* r) {
+    if (count == 0) return 0;
+    if (dim == 2) return hypervolume_2d(points, count, dim, r);
+    if (dim == 3) return hypervolume_3d(points, count, dim, r);
+    sort_descending(points, count, dim);
+    real result = 0;
+    for (size_t k = 0; k < count; ++k)
+      result += slice(points, count, dim, r, k);
+    return result;
+  }
+
+  /// Sorts the points in descending order with respect to their last
+  /// objective.
+  void sort_descending(real* points, size_t count, size_t dim) {
+    using namespace std;
+    order.resize(count);
+    iota(order.begin(), order.end(), 0);
+    sort(order.begin(), order.end(), [&](auto i, auto j) {
+      return points[dim * i + dim - 1] > points[dim * j + dim - 1];
+    });
+    buffer.assign(points, points + dim * count);
+    for (size_t i = 0; i < count; ++i)
+      copy_n(&buffer[dim * order[i]], dim, &points[dim * i]);
+  }
+
+  /// Returns the exclusive hypervolume of the point with index 'k' with
+  /// respect to all following points. The points have to be sorted in
+  /// descending order with respect to their last objective.
+  real slice(const real* points,
+             size_t count,
+             size_t dim,
+             const real* r,
+             size_t k) {
+    const auto p = &points[dim * k];
+    return (r[dim - 1] - p[dim - 1]) *
+           exclusive_hypervolume(p, &points[dim * (k + 1)], count - k - 1,
+                                 dim - 1, r);
+  }
+
+  /// Returns the hypervolume exclusively dominated by 'p' with respect to the
+  /// given points by only using the first 'dim' values of each point. All
+  /// points use a stride of 'dim + 1'.
+  real exclusive_hypervolume(const real* p,
+                             const real* points,
+                             size_t count,
+                             size_t dim,
+                             const real* r) {
+    using namespace std;
+    real box = 1;
+    for (size_t j = 0; j < dim; ++j)
+      box *= r[j] - p[j];
+
+    // Compute the limit set in the next level of scratch memory.
+    if (levels.size() <= depth) levels.resize(depth + 1);
+    auto& limits = levels[depth];
+    limits.resize(dim * count);
+    for (size_t i = 0; i < count; ++i)
+      for (size_t j = 0; j < dim; ++j)
+        limits[dim * i + j] = max(p[j], points[(dim + 1) * i + j]);
+    const auto size = remove_weakly_dominated(limits, dim);
+
+    ++depth;
+    const auto result = box - hypervolume(limits.data(), size, dim, r);
+    --depth;
+    return result;
+  }
+
+ private:
+  std::deque<std::vector<real>> levels{};
+  std::vector<size_t> order{};
+  std::vector<real> buffer{};
+  size_t depth = 0;
+};
+
+/// Computes the exclusive hypervolume contribution of each of the 'count'
+/// three-dimensional points with respect to all other points and the reference
+/// point 'r' and stores it in 'out'. The points are swept along the third
+/// objective while the non-dominated staircase of the first two objectives is
+/// maintained in a balanced tree. Every point of the staircase owns the box
+/// bounded by its neighbors and the staircase of all points inside of this box
+/// that are only dominated by itself. Its exclusive area is the area of the
+/// box not covered by its own staircase. Hence, only the points dominated by
+/// an inserted point and its neighbors have to be updated.
+/// Complexity: O(n log n)
+template <generic::real real>
+void hypervolume_contributions_3d(const real* points,
+                                  size_t count,
+                                  const real* r,
+                                  real* out) {
+  using namespace std;
+  const auto x = [points](size_t i) { return points[3 * i + 0]; };
+  const auto y = [points](size_t i) { return points[3 * i + 1]; };
+  const auto z = [points](size_t i) { return points[3 * i + 2]; };
+
+  vector<size_t> order(count);
+  iota(order.begin(), order.end(), 0);
+  sort(order.begin(), order.end(), [&](auto i, auto j) {
+    return tuple{z(i), x(i), y(i)} < tuple{z(j), x(j), y(j)};
+  });
+
+  // Every staircase maps first objectives to second objectives. Keys are
+  // increasing while values are strictly decreasing. The box of a point of
+  // the main staircase is given by 'right' and 'top'. 'covered' is the area
+  // of the box covered by its own staircase and 'level' the third objective up
+  // to which its contribution has been accumulated.
+  struct cell {
+    map<real, real> staircase{};
+    real right = 0;
+    real top = 0;
+    real covered = 0;
+    real level = 0;
+  };
+  map<real, size_t> staircase{};
+  vector<cell> cells(count);
+
+  // Accumulates the exclusive volume of a point up to the given level.
+  const auto accumulate = [&](size_t i, real level) {
+    auto& c = cells[i];
+    const auto area = (c.right - x(i)) * (c.top - y(i)) - c.covered;
+    out[i] += area * (level - c.level);
+    c.level = level;
+  };
+
+  // Inserts a point into the own staircase of the point 'i' if it lies inside
+  // of its box and updates the covered area.
+  const auto cover = [&](size_t i, real u, real v) {
+    auto& c = cells[i];
+    if (u >= c.right || v >= c.top) return;
+    auto& s = c.staircase;
+    auto it = s.upper_bound(u);
+    if (it != s.begin() && prev(it)->second <= v) return;
+    it = s.lower_bound(u);
+    real height = (it == s.begin()) ? real{0} : c.top - prev(it)->second;
+    real position = u;
+    while (it != s.end() && it->second >= v) {
+      c.covered -= (it->first - position) * height;
+      position = it->first;
+      height = c.top - it->second;
+      it = s.erase(it);
+    }
+    const auto next = (it == s.end()) ? c.right : it->first;
+    c.covered -= (next - position) * height;
+    c.covered += (next - u) * (c.top - v);
+    s.emplace_hint(it, u, v);
+  };
+
+  // Shrinks the box of the point 'i' to the given right boundary.
+  const auto shrink_right = [&](size_t i, real right) {
+    auto& c = cells[i];
+    auto& s = c.staircase;
+    auto position = c.right;
+    while (!s.empty() && prev(s.end())->first >= right) {
+      const auto last = prev(s.end());
+      c.covered -= (position - last->first) * (c.top - last->second);
+      position = last->first;
+      s.erase(last);
+    }
+    if (!s.empty())
+      c.covered -= (position - right) * (c.top - prev(s.end())->second);
+    c.right = right;
+  };
+
+  // Shrinks the box of the point 'i' to the given top boundary.
+  const auto shrink_top = [&](size_t i, real top) {
+    auto& c = cells[i];
+    auto& s = c.staircase;
+    while (!s.empty() && s.begin()->second >= top) {
+      const auto first = s.begin();
+      const auto next =
+          (std::next(first) == s.end()) ? c.right : std::next(first)->first;
+      c.covered -= (next - first->first) * (c.top - first->second);
+      s.erase(first);
+    }
+    if (!s.empty()) c.covered -= (c.top - top) * (c.right - s.begin()->first);
+    c.top = top;
+  };
+
+  for (size_t i = 0; i < count; ++i)
+    out[i] = 0;
+
+  for (auto i : order) {
+    // A point dominated in the first two objectives does not contribute but
+    // may reduce the exclusive area of the only point dominating it.
+    auto it = staircase.upper_bound(x(i));
+    if (it != staircase.begin()) {
+      const auto p = prev(it)->second;
+      if (y(p) <= y(i)) {
+        accumulate(p, z(i));
+        cover(p, x(i), y(i));
+        continue;
+      }
+    }
+
+    // All points dominated by the new point in the first two objectives are
+    // finished and build its own staircase.
+    auto& c = cells[i];
+    it = staircase.lower_bound(x(i));
+    c.top = (it == staircase.begin()) ? r[1] : y(prev(it)->second);
+    c.level = z(i);
+    while (it != staircase.end() && y(it->second) >= y(i)) {
+      const auto q = it->second;
+      accumulate(q, z(i));
+      cells[q].staircase.clear();
+      c.staircase.emplace_hint(c.staircase.end(), x(q), y(q));
+      it = staircase.erase(it);
+    }
+    c.right = (it == staircase.end()) ? r[0] : it->first;
+    for (auto k = c.staircase.begin(); k != c.staircase.end(); ++k) {
+      const auto next =
+          (std::next(k) == c.staircase.end()) ? c.right : std::next(k)->first;
+      c.covered += (next - k->first) * (c.top - k->second);
+    }
+    it = staircase.emplace_hint(it, x(i), i);
+
+    if (it != staircase.begin()) {
+      const auto a = prev(it)->second;
+      accumulate(a, z(i));
+      shrink_right(a, x(i));
+    }
+    if (next(it) != staircase.end()) {
+      const auto b = next(it)->second;
+      accumulate(b, z(i));
+      shrink_top(b, y(i));
+    }
+  }
+  for (auto [_, i] : staircase)
+    accumulate(i, r[2]);
+}
+
+/// Computes the exclusive hypervolume contribution of each of the 'count'
+/// mutually non-dominated points with 'm' values per point with respect to all
+/// other points and the reference point 'r' and stores it in 'out'. Points
+/// have to lie strictly inside the reference box and duplicates do not
+/// contribute. In two dimensions, only neighbors with respect to the first
+/// objective have to be considered. Three dimensions are handled by one sweep.
+/// Otherwise, the contribution is given by the volume of the point's box minus
+/// the hypervolume of its limit set.
+template <generic::real real>
+void hypervolume_contributions(const real* points,
+                               size_t count,
+                               size_t m,
+                               const real* r,
+                               real* out) {
+  using namespace std;
+  if (m == 2) {
+    vector<size_t> order(count);
+    iota(order.begin(), order.end(), 0);
+    sort(order.begin(), order.end(), [&](auto i, auto j) {
+      return pair{points[2 * i], points[2 * i + 1]} <
+             pair{points[2 * j], points[2 * j + 1]};
+    });
+    vector<size_t> stairs{};
+    vector<char> duplicated(count, false);
+    for (auto i : order) {
+      out[i] = 0;
+      if (!stairs.empty() &&
+          points[2 * i + 1] >= points[2 * stairs.back() + 1]) {
+        duplicated[stairs.back()] = true;
+        continue;
+      }
+      stairs.push_back(i);
+    }
+    for (size_t k = 0; k < stairs.size(); ++k) {
+      const auto i = stairs[k];
+      if (duplicated[i]) continue;
+      const auto next =
+          (k + 1 < stairs.size()) ? points[2 * stairs[k + 1]] : r[0];
+      const auto prev = (k > 0) ? points[2 * stairs[k - 1] + 1] : r[1];
+      out[i] = (next - points[2 * i]) * (prev - points[2 * i + 1]);
+    }
+    return;
+  }
+  if (m == 3) {
+    hypervolume_contributions_3d(points, count, r, out);
+    return;
+  }
+
+  wfg<real> engine{};
+  vector<real> limits{};
+  for (size_t i = 0; i < count; ++i) {
+    const auto p = &points[m * i];
+    real box = 1;
+    for (size_t j = 0; j < m; ++j)
+      box *= r[j] - p[j];
+    limits.clear();
+    for (size_t k = 0; k < count; ++k) {
+      if (k == i) continue;
+      for (size_t j = 0; j < m; ++j)
+        limits.push_back(max(p[j], points[m * k + j]));
+    }
+    const auto size = remove_weakly_dominated(limits, m);
+    out[i] = box - engine.hypervolume(limits.data(), size, m, r);
+  }
+}
+
+}  // namespace detail
+
+/// Computes the exact hypervolume of the given Pareto frontier with respect to
+/// the reference point 'reference' under the assumption that all objectives
+/// are minimized. Only points that strictly dominate the reference point
+/// contribute. For two and three objectives, sweep algorithms with a
+/// complexity of O(n log n) are used. For more objectives, a WFG-style
+/// algorithm is used whose outermost level is distributed over the given
+/// number of threads.
+template <generic::frontier frontier_type>
+auto hypervolume(const frontier_type& frontier,
+                 const std::ranges::input_range auto& reference,
+                 size_t threads = default_thread_count()) {
+  using namespace std;
+  using real = typename frontier_type::real;
+  const auto m = frontier.objective_count();
+
+  vector<real> r(ranges::begin(reference), ranges::end(reference));
+  if (r.size() != m)
+    throw invalid_argument(
+        "Dimension of reference point does not match the objective count.");
+
+  auto points = detail::hypervolume_points(frontier, span<const real>{r});
+  const auto count = points.size() / m;
+  if (count == 0) return real{0};
+
+  if (m == 1) return r[0] - *min_element(points.begin(), points.end());
+  if (m == 2) return detail::hypervolume_2d(points.data(), count, m, r.data());
+  if (m == 3) return detail::hypervolume_3d(points.data(), count, m, r.data());
+
+  const auto size = detail::remove_weakly_dominated(points, m);
+  detail::wfg<real> root{};
+  root.sort_descending(points.data(), size, m);
+
+  vector<detail::wfg<real>> engines(threads);
+  vector<real> partial(threads, 0);
+  parallel_for(
+      size,
+      [&](size_t thread, size_t first, size_t last) {
+        for (size_t k = first; k < last; ++k)
+          partial[thread] +=
+              engines[thread].slice(points.data(), size, m, r.data(), k);
+      },
+      threads);
+  return accumulate(partial.begin(), partial.end(), real{0});
+}
+
+/// Computes the exclusive hypervolume contribution of every point of the given
+/// frontier with respect to the reference point 'reference'. That is the
+/// hypervolume that would be lost by removing the respective point. The points
+/// of the frontier are assumed to be mutually non-dominated. Points not
+/// strictly dominating the reference point do not contribute.
+template <generic::frontier frontier_type>
+auto hypervolume_contributions(const frontier_type& frontier,
+                               const std::ranges::input_range auto& reference) {
+  using namespace std;
+  using real = typename frontier_type::real;
+  const auto m = frontier.objective_count();
+  const auto s = frontier.sample_count();
+
+  vector<real> r(ranges::begin(reference), ranges::end(reference));
+  if (r.size() != m)
+    throw invalid_argument(
+        "Dimension of reference point does not match the objective count.");
+
+  // Only consider points inside the reference box.
+  vector<size_t> inside{};
+  vector<real> points{};
+  for (size_t i = 0; i < s; ++i) {
+    const auto y = frontier.objectives(i);
+    if (!ranges::equal(y, r, ranges::less{})) continue;
+    inside.push_back(i);
+    points.insert(points.end(), ranges::begin(y), ranges::end(y));
+  }
+
+  vector<real> contributions(inside.size());
+  detail::hypervolume_contributions(points.data(), inside.size(), m, r.data(),
+                                    contributions.data());
+  vector<real> result(s, 0);
+  for (size_t i = 0; i < inside.size(); ++i)
+    result[inside[i]] = contributions[i];
+  return result;
+}
+
+/// Result of a Monte-Carlo estimation of the hypervolume. The error is given
+/// as the standard deviation of the estimator. Hence, the exact value lies
+/// inside of the interval [value - 2 * error, value + 2 * error] with a
+/// probability of approximately 95%.
+template <generic::real T>
+struct hypervolume_estimate {
+  using real = T;
+  real value{};
+  real error{};
+  size_t samples{};
+};
+
+/// Estimates the hypervolume of the given Pareto frontier with respect to the
+/// reference point 'reference' by uniformly sampling the bounding box spanned
+/// by the ideal point of the frontier and the reference point. The cost of the
+/// estimation grows only linearly with the number of objectives and should be
+/// preferred over the exact computation for eight or more objectives. The
+/// samples are distributed over the given number of threads. The result does
+/// not depend on the number of threads.
+template <generic::frontier frontier_type>
+auto estimate_hypervolume(const frontier_type& frontier,
+                          const std::ranges::input_range auto& reference,
+                          generic::random_number_generator auto&& rng,
+                          size_t samples = 1'000'000,
+                          size_t threads = default_thread_count()) {
+  using namespace std;
+  using real = typename frontier_type::real;
+  const auto m = frontier.objective_count();
+
+  vector<real> r(ranges::begin(reference), ranges::end(reference));
+  if (r.size() != m)
+    throw invalid_argument(
+        "Dimension of reference point does not match the objective count.");
+
+  hypervolume_estimate<real> result{.samples = samples};
+  auto points = detail::hypervolume_points(frontier, span<const real>{r});
+  const auto count = detail::remove_weakly_dominated(points, m);
+  if (count == 0 || samples == 0) return result;
+
+  // Compute the sampling box and its volume.
+  vector<real> ideal(r);
+  for (size_t i = 0; i < count; ++i)
+    for (size_t j = 0; j < m; ++j)
+      ideal[j] = min(ideal[j], points[m * i + j]);
+  real box = 1;
+  for (size_t j = 0; j < m; ++j)
+    box *= r[j] - ideal[j];
+
+  // Every chunk of samples uses its own generator to make the result
+  // independent of the scheduling of the threads.
+  constexpr size_t grain = 1 << 14;
+  const auto chunks = (samples + grain - 1) / grain;
+  const auto seed = uniform_int_distribution<uint64_t>{}(rng);
+  vector<size_t> hits(chunks, 0);
+
+  parallel_for(
+      chunks,
+      [&](size_t, size_t first, size_t last) {
+        vector<real> x(m);
+        for (size_t c = first; c < last; ++c) {
+          mt19937_64 engine{seed + c};
+          uniform_real_distribution<real> distribution{0, 1};
+          const auto n = min(grain, samples - grain * c);
+          size_t h = 0;
+          for (size_t s = 0; s < n; ++s) {
+            for (size_t j = 0; j < m; ++j)
+              x[j] = lerp(ideal[j], r[j], distribution(engine));
+            for (size_t i = 0; i < count; ++i) {
+              bool dominated = true;
+              for (size_t j = 0; j < m; ++j)
+                dominated &= (points[m * i + j] <= x[j]);
+              if (dominated) {
+                ++h;
+                break;
+              }
+            }
+          }
+          hits[c] = h;
+        }
+      },
+      threads);
+
+  const auto p =
+      real(accumulate(hits.begin(), hits.end(), size_t{0})) / samples;
+  result.value = box * p;
+  result.error = box * sqrt(p * (1 - p) / samples);
+  return result;
+}
+
+}  // namespace lyrahgames::pareto
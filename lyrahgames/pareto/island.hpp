@@ -0,0 +1,235 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <vector>
+//
+#include <lyrahgames/pareto/frontier.hpp>
+#include <lyrahgames/pareto/frontier_cast.hpp>
+#include <lyrahgames/pareto/meta.hpp>
+#include <lyrahgames/pareto/non_dominated_sort.hpp>
+#include <lyrahgames/pareto/nsga2.hpp>
+#include <lyrahgames/pareto/parallel.hpp>
+#include <lyrahgames/pareto/spsc_queue.hpp>
+#include <lyrahgames/pareto/tracing.hpp>
+
+namespace lyrahgames::pareto {
+
+namespace island {
+
+/// Graphs describing which islands send migrants to which other islands
+/// - ring: Island 'i' sends its migrants to island 'i + 1' only.
+/// - complete: Every island sends its migrants to all other islands.
+enum class topology { ring, complete };
+
+/// Island Model for the NSGA2 Algorithm
+/// Several independent NSGA2 populations are evolved concurrently on their
+/// own threads. Every few generations, each island sends randomly chosen
+/// points of its Pareto front to its neighbors in the migration topology.
+/// Migrants travel through lock-free single-producer single-consumer
+/// mailboxes. Hence, islands never wait for each other. If a mailbox is full,
+/// the migrants are dropped. The problem's 'evaluate' function has to be
+/// thread-safe.
+template <nsga2::problem T>
+class optimizer {
+ public:
+  using problem_type = T;
+  using real = typename problem_type::real;
+  using island_type = nsga2::optimizer<problem_type>;
+
+  /// Structure to provide easy intialization of the parameters of the
+  /// algorithm. By using designated initializers, named function arguments can
+  /// be simulated. The population size is given per island. Every
+  /// 'migration_interval' generations, at most 'migrants' points are sent to
+  /// every neighbor.
+  struct configuration {
+    size_t iterations = 1000;
+    size_t islands = default_thread_count();
+    size_t population = 1000;
+    float kill_ratio = 0.5;
+    float crossover_ratio = 0.3;
+    size_t migration_interval = 10;
+    size_t migrants = 10;
+    island::topology topology = topology::ring;
+  };
+
+  optimizer() = default;
+  explicit optimizer(problem_type p,
+                     generic::random_number_generator auto&& rng,
+                     configuration config = {})
+      : problem(p),
+        iter(config.iterations),
+        interval(std::max<size_t>(1, config.migration_interval)),
+        migrants(config.migrants),
+        graph(config.topology) {
+    const auto count = std::max<size_t>(1, config.islands);
+    islands.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+      islands.emplace_back(problem, rng,
+                           typename island_type::configuration{
+                               .population = config.population,
+                               .kill_ratio = config.kill_ratio,
+                               .crossover_ratio = config.crossover_ratio});
+  }
+
+  /// Returns the number of islands.
+  auto island_count() const noexcept { return islands.size(); }
+
+  /// Returns the NSGA2 optimizer of the given island.
+  const auto& island(size_t index) const noexcept { return islands[index]; }
+
+  /// Evolves all islands concurrently for the given number of generations.
+  /// Every island uses its own random number generator seeded by the given
+  /// one. Migrants that have not been received at the end are discarded.
+  void optimize(generic::random_number_generator auto&& rng,
+                size_t iterations) {
+    using namespace std;
+    const auto k = islands.size();
+    const auto m = problem.objective_count();
+    constexpr size_t mailbox_capacity = 4;
+
+    // Set up one mailbox for every directed edge of the topology.
+    deque<spsc_queue<migration>> mailboxes{};
+    vector<vector<spsc_queue<migration>*>> outgoing(k);
+    vector<vector<spsc_queue<migration>*>> incoming(k);
+    const auto connect = [&](size_t from, size_t to) {
+      auto& mailbox = mailboxes.emplace_back(mailbox_capacity);
+      outgoing[from].push_back(&mailbox);
+      incoming[to].push_back(&mailbox);
+    };
+    for (size_t i = 0; i < k; ++i) {
+      if (graph == topology::ring) {
+        if (k > 1) connect(i, (i + 1) % k);
+        continue;
+      }
+      for (size_t j = 0; j < k; ++j)
+        if (i != j) connect(i, j);
+    }
+
+    vector<uint64_t> seeds(k);
+    for (auto& seed : seeds)
+      seed = uniform_int_distribution<uint64_t>{}(rng);
+
+    parallel_for(
+        k,
+        [&](size_t, size_t first, size_t last) {
+          for (size_t i = first; i < last; ++i) {
+            auto& island = islands[i];
+            mt19937_64 local_rng{seeds[i]};
+            migration message{};
+            for (size_t g = 1; g <= iterations; ++g) {
+              island.optimize(local_rng, 1);
+              if (g % interval != 0) continue;
+
+              // Send the same emigrants to all neighbors.
+              LYRAHGAMES_PARETO_TRACE_SCOPE("island::migrate");
+              migration emigrants{};
+              island.emigrate(migrants, local_rng, emigrants.parameters,
+                              emigrants.objectives);
+              for (auto mailbox : outgoing[i]) {
+                message = emigrants;
+                mailbox->try_push(message);
+              }
+
+              // Receive all migrants that have arrived in the meantime.
+              for (auto mailbox : incoming[i])
+                while (mailbox->try_pop(message))
+                  island.immigrate(message.objectives.size() / m,
+                                   message.parameters.data(),
+                                   message.objectives.data());
+            }
+          }
+        },
+        k, 1);
+  }
+
+  /// Uses the iterations count given by construction.
+  void optimize(generic::random_number_generator auto&& rng) {
+    optimize(std::forward<decltype(rng)>(rng), iter);
+  }
+
+  /// Casts the estimated Pareto points of all islands into one usable frontier
+  /// data structure. Points dominated by other islands and duplicates are
+  /// removed.
+  template <generic::frontier frontier_type>
+  auto frontier_cast() const {
+    using namespace std;
+    const auto n = problem.parameter_count();
+    const auto m = problem.objective_count();
+
+    vector<real> parameters{};
+    vector<real> objectives{};
+    for (const auto& island : islands) {
+      const auto front = island.template frontier_cast<frontier<real>>();
+      for (size_t i = 0; i < front.sample_count(); ++i) {
+        const auto x = front.parameters(i);
+        const auto y = front.objectives(i);
+        parameters.insert(parameters.end(), x.begin(), x.end());
+        objectives.insert(objectives.end(), y.begin(), y.end());
+      }
+    }
+    const auto indices =
+        non_dominated_indices(objectives.data(), m, objectives.size() / m);
+
+    frontier_type result{indices.size(), n, m};
+    for (size_t i = 0; i < indices.size(); ++i) {
+      const auto index = indices[i];
+      {
+        auto it = result.parameters_iterator(i);
+        for (size_t j = 0; j < n; ++j, ++it)
+          *it = parameters[n * index + j];
+      }
+      {
+        auto it = result.objectives_iterator(i);
+        for (size_t j = 0; j < m; ++j, ++it)
+          *it = objectives[m * index + j];
+      }
+    }
+    return result;
+  }
+
+ private:
+  /// Message of migrants with contiguously stored parameters and objectives
+  struct migration {
+    std::vector<real> parameters{};
+    std::vector<real> objectives{};
+  };
+
+  problem_type problem{};
+  std::vector<island_type> islands{};
+
+  /// Number of iterations given by initialization.
+  size_t iter;
+  /// Number of generations between two migrations
+  size_t interval;
+  /// Maximum number of migrants per neighbor and migration
+  size_t migrants;
+  topology graph;
+};
+
+/// Short-hand function to set the parameters and optimize in one step. This
+/// function returns an instance to the island model optimizer.
+auto optimization(
+    nsga2::problem auto problem,
+    generic::random_number_generator auto&& rng,
+    typename optimizer<decltype(problem)>::configuration config = {}) {
+  optimizer result(problem, rng, config);
+  result.optimize(std::forward<decltype(rng)>(rng));
+  return result;
+}
+
+/// Short-hand function overload to additionally make a frontier cast after
+/// optimization and discard the optimizer instance in one step.
+template <generic::frontier frontier_type>
+auto optimization(
+    nsga2::problem auto problem,
+    generic::random_number_generator auto&& rng,
+    typename optimizer<decltype(problem)>::configuration config = {}) {
+  return frontier_cast<frontier_type>(
+      optimization(problem, std::forward<decltype(rng)>(rng), config));
+}
+
+}  // namespace island
+
+}  // namespace lyrahgames::pareto
@@ -0,0 +1,266 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+//
+#include <lyrahgames/pareto/meta.hpp>
+
+namespace lyrahgames::pareto {
+
+/// Metrics used for nearest-neighbor queries of a k-d tree. Every metric is
+/// separable and accumulates one term per coordinate. 'point' returns the term
+/// of a stored point 'p' with respect to the query 'q'. 'box' returns a lower
+/// bound of the term for all points whose coordinate lies inside [lo, hi].
+namespace kd_metric {
+
+/// Squared Euclidean distance
+struct squared_euclidean {
+  template <generic::real real>
+  static real point(real q, real p) noexcept {
+    const auto d = p - q;
+    return d * d;
+  }
+  template <generic::real real>
+  static real box(real q, real lo, real hi) noexcept {
+    const auto d = std::max({lo - q, q - hi, real{0}});
+    return d * d;
+  }
+};
+
+/// Squared distance measured only in the directions in which the stored point
+/// is worse than the query. It is used for the IGD+ indicator.
+struct squared_dominance {
+  template <generic::real real>
+  static real point(real q, real p) noexcept {
+    const auto d = std::max(p - q, real{0});
+    return d * d;
+  }
+  template <generic::real real>
+  static real box(real q, real lo, real /*hi*/) noexcept {
+    const auto d = std::max(lo - q, real{0});
+    return d * d;
+  }
+};
+
+/// Manhattan Distance
+struct manhattan {
+  template <generic::real real>
+  static real point(real q, real p) noexcept {
+    return std::abs(p - q);
+  }
+  template <generic::real real>
+  static real box(real q, real lo, real hi) noexcept {
+    return std::max({lo - q, q - hi, real{0}});
+  }
+};
+
+}  // namespace kd_metric
+
+/// Static k-d tree over points with an arbitrary number of coordinates. The
+/// points are reordered such that every node references a contiguous range.
+/// Coordinates are stored in a structure-of-arrays layout. Thus, the kernels
+/// at the leaves iterate over contiguous memory and can be vectorized.
+/// Every node stores the bounding box of its points for pruning.
+template <generic::real T>
+class kd_tree {
+ public:
+  using real = T;
+  static constexpr size_t leaf_size = 32;
+  static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+  kd_tree() = default;
+
+  /// Builds the tree from 'count' points with 'dim' coordinates per point
+  /// stored contiguously.
+  kd_tree(const real* points, size_t count, size_t dim) : s{count}, m{dim} {
+    using namespace std;
+    indices.resize(s);
+    iota(indices.begin(), indices.end(), 0);
+    if (s > 0) build(points, 0, s);
+    coordinates.resize(m * s);
+    for (size_t i = 0; i < s; ++i)
+      for (size_t j = 0; j < m; ++j)
+        coordinates[s * j + i] = points[m * indices[i] + j];
+  }
+
+  /// Builds the tree from the objectives of the given frontier.
+  template <generic::frontier frontier_type>
+  explicit kd_tree(const frontier_type& frontier)
+      : kd_tree{objectives_of(frontier).data(), frontier.sample_count(),
+                frontier.objective_count()} {}
+
+  /// Returns the number of stored points.
+  auto size() const noexcept { return s; }
+
+  /// Returns the number of coordinates per point.
+  auto dimension() const noexcept { return m; }
+
+  /// Returns the index of the stored point nearest to 'q' with respect to the
+  /// given metric together with its accumulated distance. The point with the
+  /// index 'exclude' is ignored.
+  template <typename metric>
+  auto nearest(const real* q, metric, size_t exclude = npos) const {
+    using namespace std;
+    constexpr auto inf = numeric_limits<real>::infinity();
+    pair<size_t, real> best{npos, inf};
+    if (s == 0) return best;
+
+    // Depth-first traversal visiting the nearer child first.
+    pair<size_t, real> stack[2 * 64];
+    size_t top = 0;
+    stack[top++] = {0, bound<metric>(0, q)};
+    while (top > 0) {
+      const auto [id, distance] = stack[--top];
+      if (distance >= best.second) continue;
+      const auto& x = nodes[id];
+      if (x.leaf()) {
+        real accumulator[leaf_size]{};
+        const auto count = x.last - x.first;
+        for (size_t j = 0; j < m; ++j) {
+          const auto column = &coordinates[s * j + x.first];
+          for (size_t i = 0; i < count; ++i)
+            accumulator[i] += metric::point(q[j], column[i]);
+        }
+        for (size_t i = 0; i < count; ++i) {
+          if (accumulator[i] >= best.second) continue;
+          if (indices[x.first + i] == exclude) continue;
+          best = {indices[x.first + i], accumulator[i]};
+        }
+        continue;
+      }
+      auto l = pair{x.left, bound<metric>(x.left, q)};
+      auto r = pair{x.right, bound<metric>(x.right, q)};
+      if (l.second < r.second) swap(l, r);
+      if (l.second < best.second) stack[top++] = l;
+      if (r.second < best.second) stack[top++] = r;
+    }
+    return best;
+  }
+
+  /// Checks if any stored point weakly dominates the point 'q'.
+  bool weakly_dominated(const real* q) const {
+    if (s == 0) return false;
+    size_t stack[64];
+    size_t top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+      const auto& x = nodes[stack[--top]];
+      const auto lo = &boxes[2 * m * (&x - nodes.data())];
+      const auto hi = lo + m;
+
+      // Prune the node if no point inside its box can dominate 'q'.
+      // Accept the node if every point inside its box dominates 'q'.
+      bool possible = true;
+      bool certain = true;
+      for (size_t j = 0; j < m; ++j) {
+        possible &= (lo[j] <= q[j]);
+        certain &= (hi[j] <= q[j]);
+      }
+      if (!possible) continue;
+      if (certain) return true;
+
+      if (x.leaf()) {
+        bool mask[leaf_size];
+        const auto count = x.last - x.first;
+        for (size_t i = 0; i < count; ++i)
+          mask[i] = true;
+        for (size_t j = 0; j < m; ++j) {
+          const auto column = &coordinates[s * j + x.first];
+          for (size_t i = 0; i < count; ++i)
+            mask[i] &= (column[i] <= q[j]);
+        }
+        for (size_t i = 0; i < count; ++i)
+          if (mask[i]) return true;
+        continue;
+      }
+      stack[top++] = x.right;
+      stack[top++] = x.left;
+    }
+    return false;
+  }
+
+ private:
+  struct node {
+    size_t first;
+    size_t last;
+    size_t left = 0;
+    size_t right = 0;
+    bool leaf() const noexcept { return left == 0; }
+  };
+
+  template <generic::frontier frontier_type>
+  static auto objectives_of(const frontier_type& frontier) {
+    std::vector<real> result{};
+    result.reserve(frontier.sample_count() * frontier.objective_count());
+    for (size_t i = 0; i < frontier.sample_count(); ++i)
+      for (auto y : frontier.objectives(i))
+        result.push_back(y);
+    return result;
+  }
+
+  /// Recursively builds the node for the given range of indices by splitting
+  /// at the median of the coordinate with the largest extent. Returns the
+  /// index of the node.
+  size_t build(const real* points, size_t first, size_t last) {
+    using namespace std;
+    const auto id = nodes.size();
+    nodes.push_back({first, last});
+    boxes.resize(2 * m * nodes.size());
+
+    auto lo = &boxes[2 * m * id];
+    auto hi = lo + m;
+    for (size_t j = 0; j < m; ++j) {
+      lo[j] = numeric_limits<real>::infinity();
+      hi[j] = -numeric_limits<real>::infinity();
+    }
+    for (size_t i = first; i < last; ++i)
+      for (size_t j = 0; j < m; ++j) {
+        lo[j] = min(lo[j], points[m * indices[i] + j]);
+        hi[j] = max(hi[j], points[m * indices[i] + j]);
+      }
+    if (last - first <= leaf_size) return id;
+
+    size_t axis = 0;
+    for (size_t j = 1; j < m; ++j)
+      if (hi[j] - lo[j] > hi[axis] - lo[axis]) axis = j;
+
+    const auto mid = first + (last - first) / 2;
+    nth_element(&indices[first], &indices[mid], &indices[0] + last,
+                [&](auto a, auto b) {
+                  return points[m * a + axis] < points[m * b + axis];
+                });
+
+    const auto left = build(points, first, mid);
+    const auto right = build(points, mid, last);
+    nodes[id].left = left;
+    nodes[id].right = right;
+    return id;
+  }
+
+  /// Lower bound of the distance of all points inside the node's box.
+  template <typename metric>
+  real bound(size_t id, const real* q) const noexcept {
+    const auto lo = &boxes[2 * m * id];
+    const auto hi = lo + m;
+    real result = 0;
+    for (size_t j = 0; j < m; ++j)
+      result += metric::box(q[j], lo[j], hi[j]);
+    return result;
+  }
+
+  /// Point Count
+  size_t s{};
+  /// Coordinate Count
+  size_t m{};
+
+  std::vector<node> nodes{};
+  std::vector<real> boxes{};
+  std::vector<real> coordinates{};
+  std::vector<size_t> indices{};
+};
+
+}  // namespace lyrahgames::pareto
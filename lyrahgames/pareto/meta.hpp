@@ -3,6 +3,7 @@
 #include <functional>
 #include <iterator>
 #include <ranges>
+#include <span>
 //
 #include <lyrahgames/xstd/forward.hpp>
 #include <lyrahgames/xstd/meta.hpp>
@@ -54,6 +55,70 @@ concept evaluatable_problem = problem<T> &&
   problem.evaluate(x, std::forward<Y>(y));
 };
 
+/// General Pareto Problems that are able to evaluate many samples at once. The
+/// parameters and objectives of all samples are stored contiguously, sample
+/// after sample. Optimizers prefer this interface if it is available.
+template <typename T>
+concept batch_evaluatable_problem = problem<T> &&
+    requires(T& problem,
+             std::span<const typename T::real> x,
+             std::span<typename T::real> y) {
+  problem.evaluate_batch(x, y);
+};
+
+/// General Pareto Problems that evaluate samples in the background. Samples
+/// handed over by 'submit' may be evaluated while the caller continues to work.
+/// Their objectives are only guaranteed to be written after 'wait' returned.
+template <typename T>
+concept asynchronously_evaluatable_problem = problem<T> &&
+    requires(T& problem,
+             std::span<const typename T::real> x,
+             std::span<typename T::real> y) {
+  problem.submit(x, y);
+  problem.wait();
+};
+
+/// General Pareto Problems that update the objectives 'parent_y' of the
+/// sample 'parent_x' to the objectives 'y' of the sample 'x', which only
+/// differs from the parent in the parameters whose indices are given by
+/// 'changed'. The costs should be proportional to the number of changed
+/// parameters instead of the number of all parameters. Repeated updates may
+/// accumulate rounding errors.
+template <typename T>
+concept delta_evaluatable_problem = problem<T> &&
+    requires(T& problem,
+             std::span<const typename T::real> parent_x,
+             std::span<const typename T::real> parent_y,
+             std::span<const size_t> changed,
+             std::span<const typename T::real> x,
+             std::span<typename T::real> y) {
+  problem.evaluate_delta(parent_x, parent_y, changed, x, y);
+};
+
+/// General Pareto Problems that know which of their parameters interact.
+/// Parameter 'i' belongs to the group 'parameter_group(i)' in the range
+/// [0, parameter_group_count()). Parameters of different groups are assumed
+/// to be separable such that optimizers may vary one group at a time.
+template <typename T>
+concept grouped_problem = problem<T> && requires(const T& problem, size_t i) {
+  { problem.parameter_group_count() } -> identical<size_t>;
+  { problem.parameter_group(i) } -> identical<size_t>;
+};
+
+/// General Pareto Problems that evaluate samples at several levels of
+/// fidelity in the range [0, fidelity_count()). Lower levels are cheaper and
+/// less accurate. Objectives of lower levels may be biased. The highest level
+/// has to agree with 'evaluate'.
+template <typename T>
+concept multi_fidelity_problem = problem<T> &&
+    requires(T& problem,
+             std::span<const typename T::real> x,
+             std::span<typename T::real> y,
+             size_t level) {
+  { problem.fidelity_count() } -> std::convertible_to<size_t>;
+  problem.evaluate(x, y, level);
+};
+
 /// Concept for General Pareto Frontiers
 template <typename T>
 concept frontier = real<typename T::real> && requires(T& v,
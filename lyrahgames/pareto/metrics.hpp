@@ -0,0 +1,153 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <ranges>
+#include <vector>
+//
+#include <lyrahgames/pareto/kd_tree.hpp>
+#include <lyrahgames/pareto/meta.hpp>
+#include <lyrahgames/pareto/parallel.hpp>
+
+namespace lyrahgames::pareto {
+
+namespace detail {
+
+/// Number of queries processed per task by the parallel metric kernels.
+constexpr size_t metric_grain = 1 << 12;
+
+/// Builds a k-d tree over 'points' and computes the mean of 'transform' applied
+/// to the nearest-neighbor distance of every objective vector in 'queries'.
+/// Partial sums are stored per chunk such that the result does not depend on
+/// the number of threads.
+template <typename metric, generic::frontier F, generic::frontier G>
+auto mean_nearest_distance(const F& queries,
+                           const G& points,
+                           auto transform,
+                           size_t threads) {
+  using namespace std;
+  using real = typename F::real;
+  const auto count = queries.sample_count();
+  if (count == 0 || points.sample_count() == 0) return real{0};
+
+  const kd_tree<real> tree{points};
+  const auto chunks = (count + metric_grain - 1) / metric_grain;
+  vector<real> partial(chunks, 0);
+  parallel_for(
+      chunks,
+      [&](size_t, size_t first, size_t last) {
+        vector<real> q(queries.objective_count());
+        for (size_t c = first; c < last; ++c) {
+          const auto end = min(count, metric_grain * (c + 1));
+          for (size_t i = metric_grain * c; i < end; ++i) {
+            ranges::copy(queries.objectives(i), q.begin());
+            partial[c] += transform(tree.nearest(q.data(), metric{}).second);
+          }
+        }
+      },
+      threads);
+  return accumulate(partial.begin(), partial.end(), real{0}) / count;
+}
+
+}  // namespace detail
+
+/// Computes the generational distance (GD) of the approximated frontier with
+/// respect to the reference frontier. It is the mean Euclidean distance of
+/// every approximated objective vector to its nearest reference point.
+/// Complexity: O(|A| log |R|) for well-distributed points
+template <generic::frontier F, generic::frontier G>
+auto generational_distance(const F& approximation,
+                           const G& reference,
+                           size_t threads = default_thread_count()) {
+  return detail::mean_nearest_distance<kd_metric::squared_euclidean>(
+      approximation, reference, [](auto d) { return std::sqrt(d); }, threads);
+}
+
+/// Computes the inverted generational distance (IGD) of the approximated
+/// frontier with respect to the reference frontier. It is the mean Euclidean
+/// distance of every reference point to its nearest approximated point.
+template <generic::frontier F, generic::frontier G>
+auto inverted_generational_distance(const F& approximation,
+                                    const G& reference,
+                                    size_t threads = default_thread_count()) {
+  return detail::mean_nearest_distance<kd_metric::squared_euclidean>(
+      reference, approximation, [](auto d) { return std::sqrt(d); }, threads);
+}
+
+/// Computes the modified inverted generational distance (IGD+). In contrast to
+/// IGD, only the objectives in which an approximated point is worse than the
+/// reference point contribute to their distance. Thereby, the indicator is
+/// weakly Pareto-compliant.
+template <generic::frontier F, generic::frontier G>
+auto inverted_generational_distance_plus(
+    const F& approximation,
+    const G& reference,
+    size_t threads = default_thread_count()) {
+  return detail::mean_nearest_distance<kd_metric::squared_dominance>(
+      reference, approximation, [](auto d) { return std::sqrt(d); }, threads);
+}
+
+/// Computes Schott's spacing metric of the given frontier. It is the standard
+/// deviation of the Manhattan distances of every point to its nearest
+/// neighbor. A value of zero means that all points are evenly spaced.
+template <generic::frontier F>
+auto spacing(const F& frontier, size_t threads = default_thread_count()) {
+  using namespace std;
+  using real = typename F::real;
+  const auto count = frontier.sample_count();
+  if (count < 2) return real{0};
+
+  const kd_tree<real> tree{frontier};
+  vector<real> distances(count);
+  parallel_for(
+      count,
+      [&](size_t, size_t first, size_t last) {
+        vector<real> q(frontier.objective_count());
+        for (size_t i = first; i < last; ++i) {
+          ranges::copy(frontier.objectives(i), q.begin());
+          distances[i] =
+              tree.nearest(q.data(), kd_metric::manhattan{}, i).second;
+        }
+      },
+      threads, detail::metric_grain);
+
+  const auto mean =
+      accumulate(distances.begin(), distances.end(), real{0}) / count;
+  real variance = 0;
+  for (auto d : distances)
+    variance += (d - mean) * (d - mean);
+  return sqrt(variance / (count - 1));
+}
+
+/// Computes the set coverage C(A, B), i.e. the fraction of points in 'b' that
+/// are weakly dominated by at least one point in 'a'. The metric is not
+/// symmetric and both directions should be taken into account when comparing
+/// two frontiers. Dominance queries are answered by a k-d tree over 'a' whose
+/// leaves are checked by a vectorized dominance kernel.
+template <generic::frontier F, generic::frontier G>
+auto coverage(const F& a, const G& b, size_t threads = default_thread_count()) {
+  using namespace std;
+  using real = typename F::real;
+  const auto count = b.sample_count();
+  if (count == 0) return real{0};
+
+  const kd_tree<real> tree{a};
+  const auto chunks = (count + detail::metric_grain - 1) / detail::metric_grain;
+  vector<size_t> partial(chunks, 0);
+  parallel_for(
+      chunks,
+      [&](size_t, size_t first, size_t last) {
+        vector<real> q(b.objective_count());
+        for (size_t c = first; c < last; ++c) {
+          const auto end = min(count, detail::metric_grain * (c + 1));
+          for (size_t i = detail::metric_grain * c; i < end; ++i) {
+            ranges::copy(b.objectives(i), q.begin());
+            partial[c] += tree.weakly_dominated(q.data());
+          }
+        }
+      },
+      threads);
+  return real(accumulate(partial.begin(), partial.end(), size_t{0})) / count;
+}
+
+}  // namespace lyrahgames::pareto
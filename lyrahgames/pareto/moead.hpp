@@ -0,0 +1,424 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <span>
+#include <vector>
+//
+#include <lyrahgames/pareto/frontier_cast.hpp>
+#include <lyrahgames/pareto/meta.hpp>
+#include <lyrahgames/pareto/non_dominated_sort.hpp>
+#include <lyrahgames/pareto/parallel.hpp>
+#include <lyrahgames/pareto/reference_points.hpp>
+#include <lyrahgames/pareto/tracing.hpp>
+#include <lyrahgames/pareto/variation.hpp>
+
+namespace lyrahgames::pareto {
+
+namespace moead {
+
+/// Specialized Pareto Problems for the MOEA/D Algorithm
+template <typename T>
+concept problem = generic::evaluatable_problem<T,
+                                               std::span<typename T::real>,
+                                               std::span<typename T::real>>;
+
+/// Scalarization functions to decompose the multi-objective problem into
+/// single-objective subproblems
+enum class decomposition { tchebycheff, penalty_boundary_intersection };
+
+/// MOEA/D Optimization Algorithm
+/// Every individual of the population is the current best solution of a
+/// scalar subproblem given by a weight vector. Offspring are generated from
+/// and compared to the individuals of the nearest weight vectors only. Hence,
+/// no global sorting is needed and the costs per evaluation are linear in the
+/// neighborhood size. If more than one thread is used, all subproblems of a
+/// generation are processed in parallel and individuals are guarded by striped
+/// locks. In this case, the problem's 'evaluate' function has to be
+/// thread-safe and the order of updates, and therefore the result, is not
+/// reproducible. By default, only one thread is used.
+template <problem T>
+class optimizer {
+ public:
+  using problem_type = T;
+  using real = typename problem_type::real;
+
+  /// Structure to provide easy intialization of the parameters of the
+  /// algorithm. By using designated initializers, named function arguments can
+  /// be simulated. The population is rounded up to the next size of a simplex
+  /// lattice of weight vectors. With a probability given by
+  /// 'neighborhood_ratio', parents are chosen from the neighborhood and
+  /// otherwise from the whole population. Every offspring replaces at most
+  /// 'replacements' individuals.
+  struct configuration {
+    size_t iterations = 1000;
+    size_t population = 100;
+    size_t neighborhood = 20;
+    moead::decomposition decomposition = decomposition::tchebycheff;
+    float penalty = 5;
+    float neighborhood_ratio = 0.9;
+    size_t replacements = 2;
+    float crossover_ratio = 0.5;
+    size_t threads = 1;
+  };
+
+  optimizer() = default;
+  explicit optimizer(problem_type p,
+                     generic::random_number_generator auto&& rng,
+                     configuration config = {})
+      : problem(p),
+        iter(config.iterations),
+        method(config.decomposition),
+        penalty(config.penalty),
+        neighborhood_probability(config.neighborhood_ratio),
+        replacements(std::max<size_t>(1, config.replacements)),
+        crossover_probability(config.crossover_ratio),
+        threads(std::max<size_t>(1, config.threads)) {
+    init(config.population, config.neighborhood);
+    init_population(std::forward<decltype(rng)>(rng));
+  }
+
+  /// Generates the weight vectors and their neighborhoods.
+  void init(size_t population, size_t neighborhood) {
+    using namespace std;
+    const auto n = problem.parameter_count();
+    const auto m = problem.objective_count();
+
+    // Choose the smallest simplex lattice that provides enough weights.
+    size_t divisions = 0;
+    size_t count = 1;
+    for (; (m > 1) && (count < population); ++divisions)
+      count = count * (divisions + m) / (divisions + 1);
+    weights = simplex_lattice<real>(m, divisions);
+    if (m == 1) weights.assign(max<size_t>(1, population), 1);
+    s = weights.size() / m;
+
+    parameters.resize(n * s);
+    objectives.resize(m * s);
+
+    // Precompute the 't' nearest weight vectors of every weight vector. The
+    // weight vector itself always is the first of its neighbors.
+    t = clamp<size_t>(neighborhood, 1, s);
+    neighbors.resize(t * s);
+    parallel_for(
+        s,
+        [&](size_t, size_t first, size_t last) {
+          vector<pair<real, size_t>> distances(s);
+          for (size_t i = first; i < last; ++i) {
+            for (size_t j = 0; j < s; ++j) {
+              real d = 0;
+              for (size_t k = 0; k < m; ++k) {
+                const auto x = weights[m * i + k] - weights[m * j + k];
+                d += x * x;
+              }
+              distances[j] = {(i == j) ? real{-1} : d, j};
+            }
+            partial_sort(distances.begin(), distances.begin() + t,
+                         distances.end());
+            for (size_t k = 0; k < t; ++k)
+              neighbors[t * i + k] = distances[k].second;
+          }
+        },
+        threads, 16);
+
+    // Prepare the weight vectors for the chosen scalarization.
+    constexpr real epsilon = 1e-4;
+    for (size_t i = 0; i < s; ++i) {
+      const auto w = &weights[m * i];
+      if (method == decomposition::tchebycheff) {
+        for (size_t k = 0; k < m; ++k)
+          w[k] = max(w[k], epsilon);
+      } else {
+        real norm = 0;
+        for (size_t k = 0; k < m; ++k)
+          norm += w[k] * w[k];
+        norm = sqrt(norm);
+        for (size_t k = 0; k < m; ++k)
+          w[k] /= norm;
+      }
+    }
+
+    ideal.assign(m, numeric_limits<real>::infinity());
+    workers.resize(threads);
+    for (auto& w : workers) {
+      w.x.resize(n);
+      w.y.resize(m);
+      w.scratch.resize(n);
+      w.parent1.resize(n);
+      w.parent2.resize(n);
+      w.ideal.resize(m);
+      w.order.resize(s);
+      iota(w.order.begin(), w.order.end(), 0);
+    }
+  }
+
+  /// Returns the number of subproblems which equals the population size.
+  auto population_size() const noexcept { return s; }
+
+  /// Evaluate all objectives at the given index by using the parameters
+  /// referenced by the given index.
+  void evaluate(size_t index) {
+    using std::span;
+    const auto n = problem.parameter_count();
+    const auto m = problem.objective_count();
+    problem.evaluate(
+        span{&parameters[n * index], &parameters[n * (index + 1)]},
+        span{&objectives[m * index], &objectives[m * (index + 1)]});
+  }
+
+  /// Generates a random population to start with the optimization algorithm.
+  void init_population(generic::random_number_generator auto&& rng) {
+    using namespace std;
+    const auto n = problem.parameter_count();
+    const auto m = problem.objective_count();
+
+    uniform_real_distribution<real> distribution{0, 1};
+    const auto random = [&] { return distribution(rng); };
+
+    for (size_t i = 0; i < s; ++i) {
+      for (size_t j = 0; j < n; ++j)
+        parameters[n * i + j] =
+            lerp(problem.box_min(j), problem.box_max(j), random());
+      evaluate(i);
+      for (size_t j = 0; j < m; ++j)
+        ideal[j] = min(ideal[j], objectives[m * i + j]);
+    }
+  }
+
+  /// Returns the scalarized value of the objectives 'y' with respect to the
+  /// weight vector of the given subproblem and the ideal point 'z'.
+  real scalarize(size_t index, const real* y, const real* z) const {
+    using namespace std;
+    const auto m = problem.objective_count();
+    const auto w = &weights[m * index];
+    if (method == decomposition::tchebycheff) {
+      real result = 0;
+      for (size_t k = 0; k < m; ++k)
+        result = max(result, w[k] * abs(y[k] - z[k]));
+      return result;
+    }
+    // Penalty-based boundary intersection with normalized weight vectors
+    real d1 = 0;
+    for (size_t k = 0; k < m; ++k)
+      d1 += (y[k] - z[k]) * w[k];
+    real d2 = 0;
+    for (size_t k = 0; k < m; ++k) {
+      const auto x = y[k] - z[k] - d1 * w[k];
+      d2 += x * x;
+    }
+    return d1 + penalty * sqrt(d2);
+  }
+
+  /// Generates one offspring for the given subproblem and uses it to replace
+  /// worse individuals of the mating pool. The scratch memory of the given
+  /// thread is used. If 'locks' is not null, every access to an individual is
+  /// guarded by its striped lock.
+  void update(size_t index,
+              size_t thread,
+              generic::random_number_generator auto&& rng,
+              std::mutex* locks) {
+    using namespace std;
+    const auto n = problem.parameter_count();
+    const auto m = problem.objective_count();
+    auto& w = workers[thread];
+
+    const auto guard = [&](size_t i) {
+      unique_lock<mutex> lock{};
+      if (locks) lock = unique_lock<mutex>{locks[i % lock_count]};
+      return lock;
+    };
+    const auto load = [&](size_t i, vector<real>& x) {
+      const auto lock = guard(i);
+      copy_n(&parameters[n * i], n, x.begin());
+    };
+
+    // Choose the mating pool from the neighborhood or the whole population.
+    uniform_real_distribution<float> distribution{0, 1};
+    const bool local = distribution(rng) < neighborhood_probability;
+    auto pool = w.order.data();
+    size_t pool_size = s;
+    if (local) {
+      w.pool.assign(&neighbors[t * index], &neighbors[t * (index + 1)]);
+      pool = w.pool.data();
+      pool_size = t;
+    }
+    uniform_int_distribution<size_t> random_member{0, pool_size - 1};
+
+    // Generate and evaluate the offspring.
+    if (distribution(rng) < crossover_probability) {
+      load(pool[random_member(rng)], w.parent1);
+      load(pool[random_member(rng)], w.parent2);
+      simulated_binary_crossover(n, w.parent1.data(), w.parent2.data(),
+                                 w.x.data(), w.scratch.data(), rng);
+    } else {
+      load(pool[random_member(rng)], w.parent1);
+      alternate_random_mutation(problem, w.parent1.data(), w.x.data(), rng);
+    }
+    for (size_t j = 0; j < n; ++j)
+      w.x[j] = clamp(w.x[j], problem.box_min(j), problem.box_max(j));
+    problem.evaluate(span{w.x}, span{w.y});
+    for (size_t j = 0; j < m; ++j)
+      w.ideal[j] = min(w.ideal[j], w.y[j]);
+
+    // Visit the mating pool in random order by a partial Fisher-Yates shuffle
+    // and replace worse individuals.
+    size_t replaced = 0;
+    for (size_t k = 0; (k < pool_size) && (replaced < replacements); ++k) {
+      swap(pool[k], pool[uniform_int_distribution<size_t>{k, pool_size - 1}(
+                        rng)]);
+      const auto j = pool[k];
+      const auto value = scalarize(j, w.y.data(), w.ideal.data());
+      const auto lock = guard(j);
+      if (value > scalarize(j, &objectives[m * j], w.ideal.data())) continue;
+      copy(w.x.begin(), w.x.end(), &parameters[n * j]);
+      copy(w.y.begin(), w.y.end(), &objectives[m * j]);
+      ++replaced;
+    }
+  }
+
+  /// Generates one offspring for every subproblem. With a single thread, the
+  /// given random number generator is used directly and the ideal point is
+  /// updated immediately. Otherwise, every chunk of subproblems uses its own
+  /// generator seeded by the given one and threads update their own copy of
+  /// the ideal point which is merged after the generation.
+  void step(generic::random_number_generator auto&& rng) {
+    LYRAHGAMES_PARETO_TRACE_SCOPE("moead::step");
+    using namespace std;
+    const auto m = problem.objective_count();
+    constexpr size_t grain = 8;
+
+    for (auto& w : workers)
+      copy(ideal.begin(), ideal.end(), w.ideal.begin());
+
+    if ((threads == 1) || (s <= grain)) {
+      for (size_t i = 0; i < s; ++i)
+        update(i, 0, rng, nullptr);
+    } else {
+      const auto seed = uniform_int_distribution<uint64_t>{}(rng);
+      vector<mutex> locks(lock_count);
+      parallel_for(
+          s,
+          [&](size_t thread, size_t first, size_t last) {
+            mt19937_64 local_rng{seed + first};
+            for (size_t i = first; i < last; ++i)
+              update(i, thread, local_rng, locks.data());
+          },
+          threads, grain);
+    }
+
+    for (const auto& w : workers)
+      for (size_t j = 0; j < m; ++j)
+        ideal[j] = min(ideal[j], w.ideal[j]);
+  }
+
+  /// This function can be applied multiple times to further improve the
+  /// estimation of the Pareto frontier.
+  void optimize(generic::random_number_generator auto&& rng,
+                size_t iterations) {
+    for (size_t i = 0; i < iterations; ++i)
+      step(rng);
+  }
+
+  /// Uses the iterations count given by construction.
+  void optimize(generic::random_number_generator auto&& rng) {
+    optimize(std::forward<decltype(rng)>(rng), iter);
+  }
+
+  /// Casts the estimated Pareto points stored as an implementation detail into
+  /// a usable frontier data structure. Only the non-dominated individuals of
+  /// the population are used and duplicates are removed.
+  template <generic::frontier frontier_type>
+  auto frontier_cast() const {
+    using namespace std;
+    const auto n = problem.parameter_count();
+    const auto m = problem.objective_count();
+
+    const auto indices = non_dominated_indices(objectives.data(), m, s);
+    frontier_type frontier{indices.size(), n, m};
+    for (size_t i = 0; i < indices.size(); ++i) {
+      const auto index = indices[i];
+      {
+        auto it = frontier.parameters_iterator(i);
+        for (size_t j = 0; j < n; ++j, ++it)
+          *it = parameters[n * index + j];
+      }
+      {
+        auto it = frontier.objectives_iterator(i);
+        for (size_t j = 0; j < m; ++j, ++it)
+          *it = objectives[m * index + j];
+      }
+    }
+    return frontier;
+  }
+
+ private:
+  /// Thread-local scratch memory for the generation of offspring
+  struct worker {
+    std::vector<real> x{};
+    std::vector<real> y{};
+    std::vector<real> scratch{};
+    std::vector<real> parent1{};
+    std::vector<real> parent2{};
+    std::vector<real> ideal{};
+    std::vector<size_t> pool{};
+    std::vector<size_t> order{};
+  };
+
+  /// Number of striped locks used to guard individuals in parallel updates
+  static constexpr size_t lock_count = 64;
+
+  problem_type problem{};
+
+  std::vector<real> parameters{};
+  std::vector<real> objectives{};
+  std::vector<real> weights{};
+  std::vector<size_t> neighbors{};
+  std::vector<real> ideal{};
+  std::vector<worker> workers{};
+
+  /// Population Size
+  size_t s;
+  /// Neighborhood Size
+  size_t t;
+  /// Number of iterations given by initialization.
+  size_t iter;
+  decomposition method;
+  /// Penalty Parameter of the PBI Scalarization
+  real penalty;
+  float neighborhood_probability;
+  /// Maximum Number of Replacements per Offspring
+  size_t replacements;
+  /// Crossover/Mutation Ratio per Offspring
+  float crossover_probability;
+  size_t threads;
+};
+
+/// Short-hand function to set the parameters and optimize in one step. This
+/// function returns an instance to the MOEA/D optimizer.
+auto optimization(
+    problem auto problem,
+    generic::random_number_generator auto&& rng,
+    typename optimizer<decltype(problem)>::configuration config = {}) {
+  optimizer result(problem, rng, config);
+  result.optimize(std::forward<decltype(rng)>(rng));
+  return result;
+}
+
+/// Short-hand function overload to additionally make a frontier cast after
+/// optimization and discard the optimizer instance in one step.
+template <generic::frontier frontier_type>
+auto optimization(
+    problem auto problem,
+    generic::random_number_generator auto&& rng,
+    typename optimizer<decltype(problem)>::configuration config = {}) {
+  return frontier_cast<frontier_type>(
+      optimization(problem, std::forward<decltype(rng)>(rng), config));
+}
+
+}  // namespace moead
+
+}  // namespace lyrahgames::pareto
@@ -2,14 +2,21 @@
 #include <algorithm>
 #include <cmath>
 #include <concepts>
+#include <cstdint>
 #include <map>
 #include <random>
 #include <ranges>
 #include <span>
+#include <stdexcept>
+#include <vector>
 //
+#include <lyrahgames/pareto/batch.hpp>
+#include <lyrahgames/pareto/budget.hpp>
 #include <lyrahgames/pareto/domination.hpp>
 #include <lyrahgames/pareto/frontier_cast.hpp>
 #include <lyrahgames/pareto/meta.hpp>
+#include <lyrahgames/pareto/sampling.hpp>
+#include <lyrahgames/pareto/tracing.hpp>
 
 namespace lyrahgames::pareto {
 
@@ -22,9 +29,10 @@ concept problem = generic::evaluatable_problem<T,
                                                std::vector<typename T::real>>;
 
 /// Naive Monte-Carlo-based Pareto Optimization Algorithm
-/// Generates uniformly distributed random samples inside the box constraints of
-/// the given problem and keeps all non-dominated points inside a map data
-/// structure.
+/// Generates samples inside the box constraints of the given problem and keeps
+/// all non-dominated points inside a map data structure. Samples are uniformly
+/// distributed by default. Low-discrepancy sequences or Latin hypercube designs
+/// cover the box more evenly for the same number of evaluations.
 template <problem T>
 class optimizer {
  public:
@@ -38,51 +46,90 @@ class optimizer {
 
   explicit optimizer(problem_type p) : problem(p) {}
 
+  /// Samples the problem by the given method. Quasi-random sequences start at
+  /// the given index such that several workers can evaluate disjoint parts of
+  /// the same sequence.
+  optimizer(problem_type p, sampling method, uint64_t start = 0)
+      : problem(p),
+        samples(method, p.parameter_count(), start),
+        offset(start) {}
+
+  /// Starts over with a new problem by discarding all found Pareto optima.
+  /// The sampling method is kept and its sequence is restarted.
+  void reset(problem_type p) { reset(p, samples.method(), offset); }
+
+  /// Starts over with a new problem and sampling method.
+  void reset(problem_type p, sampling method, uint64_t start = 0) {
+    problem = p;
+    pareto_optima.clear();
+    samples = sampler<real>{method, problem.parameter_count(), start};
+    offset = start;
+    evaluations = 0;
+  }
+
   /// Estimate the Pareto frontier of the given problem. This function can be
   /// called multiple times to further improve the estimate.
   void optimize(generic::random_number_generator auto&& rng,
                 size_t iterations = 1000) {
-    using namespace std;
-
-    // Generate oracle for random numbers.
-    uniform_real_distribution<real> distribution{0, 1};
-    const auto random = [&] { return distribution(rng); };
+    // Use number of Monte-Carlo iterations to estimate the Pareto front.
+    for (size_t first = 0; first < iterations; first += block)
+      sample_block(rng, std::min(block, iterations - first), budget{});
+  }
 
-    // Introduce short-hand notations.
-    const auto n = problem.parameter_count();
+  /// Estimates the Pareto frontier until the given budget is exhausted. At
+  /// least one of its limits has to be given. The deadline is checked before
+  /// every evaluation or, for batch evaluations, before every block of
+  /// samples. Every block counts as one step of the stagnation detection. The
+  /// estimate is valid after every evaluation.
+  void optimize(generic::random_number_generator auto&& rng,
+                const budget& limits) {
+    using namespace std;
+    if (limits.evaluations == 0 && limits.stagnation == 0 &&
+        limits.deadline == budget::clock::time_point::max())
+      throw invalid_argument("naive: budget does not limit the optimization");
     const auto m = problem.objective_count();
+    stagnation_detector<real> progress{limits};
+    vector<real> front{};
+    while (limits.remaining(evaluations) > 0 && !limits.expired() &&
+           !progress.stagnated()) {
+      const auto count = min(block, limits.remaining(evaluations));
+      const auto changed = sample_block(rng, count, limits);
+      progress.update(changed, m, [&] {
+        front.clear();
+        for (const auto& [y, _] : pareto_optima)
+          front.insert(front.end(), y.begin(), y.end());
+        return span<const real>{front};
+      });
+    }
+  }
 
-    // Vectors for evaluating and storing temporary problem configurations.
-    parameter_vector x(n);
-    objective_vector y(m);
+  /// Returns the number of evaluations since the start.
+  auto evaluation_count() const noexcept { return evaluations; }
 
-    // Use number of Monte-Carlo iterations to estimate the Pareto front.
-    for (size_t s = 0; s < iterations; ++s) {
-      // Get random parameter vector inside box constaints.
-      for (size_t k = 0; k < n; ++k)
-        x[k] = lerp(problem.box_min(k), problem.box_max(k), random());
-
-      // Evaluate its objective values.
-      problem.evaluate(x, y);
-
-      // Check if it is a non-dominated point.
-      bool non_dominated = true;
-      for (auto it = begin(pareto_optima); it != end(pareto_optima);) {
-        const auto& [p, _] = *it;
-        if (dominates(p, y)) {
-          non_dominated = false;
-          break;
-        }
-        // Delete points that are dominated.
-        if (dominates(y, p))
-          it = pareto_optima.erase(it);
-        else
-          ++it;
-      }
+  /// Inserts the given sample if it is not dominated by the current estimate
+  /// and removes all points of the estimate it dominates. Returns true if the
+  /// sample has been inserted.
+  bool insert(const parameter_vector& x, const objective_vector& y) {
+    using namespace std;
 
-      // Insert non-dominated points into the map.
-      if (non_dominated) pareto_optima.emplace(y, x);
+    // Check if it is a non-dominated point.
+    bool non_dominated = true;
+    for (auto it = begin(pareto_optima); it != end(pareto_optima);) {
+      const auto& [p, _] = *it;
+      if (dominates(p, y)) {
+        non_dominated = false;
+        break;
+      }
+      // Delete points that are dominated.
+      if (dominates(y, p))
+        it = pareto_optima.erase(it);
+      else
+        ++it;
     }
+
+    // Insert non-dominated points into the map.
+    if (non_dominated) pareto_optima.emplace(y, x);
+    return non_dominated;
   }
 
   /// Casts the estimated Pareto points stored as an implementation detail into
@@ -101,8 +148,63 @@ class optimizer {
   }
 
  private:
+  /// Number of samples generated at once
+  static constexpr size_t block = 1024;
+
+  /// Evaluates a block of 'count' samples and inserts them into the estimate.
+  /// No evaluation is started after the deadline of the given budget. Returns
+  /// true if the estimate changed.
+  bool sample_block(generic::random_number_generator auto&& rng,
+                    size_t count,
+                    const budget& limits) {
+    using namespace std;
+    LYRAHGAMES_PARETO_TRACE_SCOPE("naive::block");
+
+    // Introduce short-hand notations.
+    const auto n = problem.parameter_count();
+    const auto m = problem.objective_count();
+
+    // Vectors for evaluating and storing temporary problem configurations.
+    // Samples are generated in blocks such that Latin hypercube designs
+    // stratify more than one sample.
+    parameters.resize(n);
+    objectives.resize(m);
+    block_parameters.resize(n * count);
+    block_objectives.resize(m * count);
+    samples.sample(problem, count, block_parameters.data(), rng);
+
+    bool changed = false;
+    if constexpr (generic::batch_evaluatable_problem<problem_type>) {
+      if (limits.expired()) return false;
+      evaluations += count;
+      problem.evaluate_batch(span<const real>{block_parameters},
+                             span<real>{block_objectives});
+      for (size_t i = 0; i < count; ++i) {
+        copy_n(&block_parameters[n * i], n, parameters.begin());
+        copy_n(&block_objectives[m * i], m, objectives.begin());
+        changed |= insert(parameters, objectives);
+      }
+    } else {
+      for (size_t i = 0; i < count && !limits.expired(); ++i) {
+        copy_n(&block_parameters[n * i], n, parameters.begin());
+        ++evaluations;
+        problem.evaluate(parameters, objectives);
+        changed |= insert(parameters, objectives);
+      }
+    }
+    return changed;
+  }
+
   problem_type problem{};
   container pareto_optima{};
+  sampler<real> samples{sampling::uniform, problem.parameter_count()};
+  uint64_t offset = 0;
+  size_t evaluations = 0;
+  /// Scratch memory for the evaluated samples
+  parameter_vector parameters{};
+  objective_vector objectives{};
+  parameter_vector block_parameters{};
+  objective_vector block_objectives{};
 };
 
 template <problem problem_type>
@@ -112,8 +214,9 @@ optimizer(problem_type) -> optimizer<problem_type>;
 /// function returns an instance to the naive optimizer.
 auto optimization(problem auto problem,
                   generic::random_number_generator auto&& rng,
-                  size_t iterations) {
-  optimizer result(problem);
+                  size_t iterations,
+                  sampling method = sampling::uniform) {
+  optimizer result(problem, method);
   result.optimize(std::forward<decltype(rng)>(rng), iterations);
   return result;
 }
@@ -123,9 +226,45 @@ auto optimization(problem auto problem,
 template <generic::frontier frontier_type>
 auto optimization(problem auto problem,
                   generic::random_number_generator auto&& rng,
-                  size_t iterations) {
-  return frontier_cast<frontier_type>(
-      optimization(problem, std::forward<decltype(rng)>(rng), iterations));
+                  size_t iterations,
+                  sampling method = sampling::uniform) {
+  return frontier_cast<frontier_type>(optimization(
+      problem, std::forward<decltype(rng)>(rng), iterations, method));
+}
+
+/// Independent optimization of a batch. The seed initializes the random
+/// number generator of the job such that results do not depend on the order
+/// of execution.
+template <problem problem_type>
+struct job {
+  problem_type problem{};
+  size_t iterations = 1000;
+  uint64_t seed = 0;
+  sampling method = sampling::uniform;
+};
+
+/// Runs all given jobs concurrently on a shared pool of threads and calls
+/// 'sink(index, frontier)' in completion order. Every thread reuses one
+/// optimizer instance for all of its jobs. Jobs with more evaluations are
+/// started first.
+template <generic::frontier frontier_type, problem problem_type>
+void batch_optimization(const std::vector<job<problem_type>>& jobs,
+                        auto&& sink,
+                        size_t threads = default_thread_count()) {
+  using namespace std;
+  vector<double> costs(jobs.size());
+  for (size_t i = 0; i < jobs.size(); ++i)
+    costs[i] = double(jobs[i].iterations);
+  run_batch<optimizer<problem_type>>(
+      jobs.size(),
+      [&](auto& instance, size_t index) {
+        const auto& job = jobs[index];
+        mt19937_64 rng{job.seed};
+        instance.reset(job.problem, job.method);
+        instance.optimize(rng, job.iterations);
+        return instance.template frontier_cast<frontier_type>();
+      },
+      sink, costs, threads);
 }
 
 }  // namespace naive
@@ -0,0 +1,134 @@
+#pragma once
+#include <algorithm>
+#include <numeric>
+#include <span>
+#include <unordered_set>
+#include <vector>
+//
+#include <lyrahgames/pareto/domination.hpp>
+#include <lyrahgames/pareto/meta.hpp>
+
+namespace lyrahgames::pareto {
+
+/// Sorts the 'count' objective vectors with 'm' values each, stored
+/// contiguously in 'objectives', into their layers of domination until at
+/// least 'select' points have been sorted. We use a permutation array to not
+/// have to copy all vectors. After sorting, the best layers are stored at the
+/// end of the permutation. The elements of the 'fronts' array mark the
+/// beginning of a new Pareto front beginning from the end with respect to the
+/// permutation. 'pareto_indices' is used as scratch memory.
+template <generic::real real>
+void non_dominated_sort(const real* objectives,
+                        size_t m,
+                        size_t count,
+                        size_t select,
+                        std::vector<size_t>& permutation,
+                        std::vector<size_t>& fronts,
+                        std::unordered_set<size_t>& pareto_indices) {
+  using namespace std;
+
+  permutation.resize(count);
+  iota(permutation.begin(), permutation.end(), 0);
+
+  fronts.resize(1);
+  fronts[0] = 0;
+
+  // Sort front-wise until enough points are reached.
+  while (fronts.back() < select) {
+    pareto_indices.clear();
+    pareto_indices.insert(permutation[0]);
+
+    // Marks the number of currently dominated points.
+    size_t front = 0;
+
+    // Already known pareto points have already been put at the end.
+    // So iterate only over dominated points from the last iteration.
+    for (size_t i = 1; i < count - fronts.back(); ++i) {
+      // Reference the objectives of the current point with respect to the
+      // permutation.
+      const auto index = permutation[i];
+      auto p = span{&objectives[m * index], &objectives[m * (index + 1)]};
+
+      // Check this point for domination against all other points currently
+      // assumed to be Pareto points.
+      bool non_dominated = true;
+      auto it = begin(pareto_indices);
+      for (; it != end(pareto_indices);) {
+        // Reference the objectives of an assumed Pareto point.
+        const auto j = *it;
+        auto q = span{&objectives[m * j], &objectives[m * (j + 1)]};
+
+        // Every dominated point will be put in the permutation front.
+        // At the end, all pareto points will be put at the end of the current
+        // permutation.
+
+        // If the current point is dominated by the assumed Pareto point then
+        // put it at the front of the permutation.
+        if (dominates(q, p)) {
+          non_dominated = false;
+          permutation[front] = index;
+          ++front;
+          break;
+        }
+
+        // If it dominates other assumed Pareto points then remove the assumed
+        // Pareto point and put its index at the front of the permutation.
+        if (dominates(p, q)) {
+          it = pareto_indices.erase(it);
+          permutation[front] = j;
+          ++front;
+        } else {
+          ++it;
+        }
+      }
+
+      if (non_dominated) pareto_indices.insert(index);
+    }
+
+    // Order dominated points in reverse order. Heuristic to fasten up
+    // sorting. Apart from performance, there is no logical reason to do this.
+    // The algorithm would be able to work without it.
+    for (size_t i = 0; i < front / 2; ++i)
+      swap(permutation[i], permutation[front - 1 - i]);
+
+    // Put all Pareto points after the dominated points.
+    for (auto j : pareto_indices) {
+      permutation[front] = j;
+      ++front;
+    }
+    // Mark the current front.
+    fronts.push_back(fronts.back() + pareto_indices.size());
+  }
+}
+
+/// Returns the indices of all non-dominated points of the 'count' objective
+/// vectors with 'm' values each, stored contiguously in 'objectives'. Points
+/// with identical objectives are only reported once. The indices are sorted
+/// lexicographically with respect to the objectives of their points.
+template <generic::real real>
+auto non_dominated_indices(const real* objectives, size_t m, size_t count) {
+  using namespace std;
+
+  vector<size_t> permutation{};
+  vector<size_t> fronts{};
+  unordered_set<size_t> pareto_indices{};
+  non_dominated_sort(objectives, m, count, 1, permutation, fronts,
+                     pareto_indices);
+
+  vector<size_t> indices(permutation.end() - fronts[1], permutation.end());
+  const auto less = [&](size_t i, size_t j) {
+    return lexicographical_compare(&objectives[m * i],
+                                   &objectives[m * (i + 1)],
+                                   &objectives[m * j],
+                                   &objectives[m * (j + 1)]);
+  };
+  const auto equal = [&](size_t i, size_t j) {
+    return std::equal(&objectives[m * i], &objectives[m * (i + 1)],
+                      &objectives[m * j]);
+  };
+  sort(indices.begin(), indices.end(), less);
+  indices.erase(unique(indices.begin(), indices.end(), equal), indices.end());
+  return indices;
+}
+
+}  // namespace lyrahgames::pareto
@@ -1,6 +1,8 @@
 #pragma once
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
 #include <limits>
@@ -8,12 +10,23 @@
 #include <random>
 #include <ranges>
 #include <span>
-#include <unordered_set>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 //
+#include <lyrahgames/pareto/batch.hpp>
+#include <lyrahgames/pareto/budget.hpp>
 #include <lyrahgames/pareto/domination.hpp>
+#include <lyrahgames/pareto/evaluation_scheduler.hpp>
+#include <lyrahgames/pareto/frontier.hpp>
 #include <lyrahgames/pareto/frontier_cast.hpp>
 #include <lyrahgames/pareto/meta.hpp>
+#include <lyrahgames/pareto/observer.hpp>
+#include <lyrahgames/pareto/ranked_population.hpp>
+#include <lyrahgames/pareto/sampling.hpp>
+#include <lyrahgames/pareto/surrogate.hpp>
+#include <lyrahgames/pareto/tracing.hpp>
+#include <lyrahgames/pareto/variation.hpp>
 
 namespace lyrahgames::pareto {
 
@@ -25,9 +38,16 @@ concept problem = generic::evaluatable_problem<T,
                                                std::span<typename T::real>,
                                                std::span<typename T::real>>;
 
+/// Sources that can seed the population of the NSGA2 optimizer, like
+/// frontiers, snapshots, and other optimizers
+template <typename T, typename real>
+concept seed = generic::frontier<T> ||
+               generic::frontier_castable<T, frontier<real>>;
+
 /// NSGA2 Optimization Algorithm with Custom Implementation of the Non-Dominated
 /// Sorting Algorithm, Simulated Binary Crossovers, and Alternate Random
-/// Mutations
+/// Mutations. The domination layers are kept persistent between generations
+/// such that only discarded points and offspring have to be sorted.
 template <problem T>
 class optimizer {
  public:
@@ -36,35 +56,162 @@ class optimizer {
 
   /// Structure to provide easy intialization of the parameters of the
   /// algorithm. By using designated initializers, named function arguments can
-  /// be simulated.
+  /// be simulated. For more than one thread, offspring are evaluated
+  /// concurrently and the problem's 'evaluate' function has to be thread-safe.
+  /// A positive number of sentinels enables the dynamic mode for problems
+  /// whose objectives change over time. See 'detect_change'. The initial
+  /// population is sampled by the given method. Low-discrepancy samples cover
+  /// the parameter box more evenly than uniformly distributed ones.
+  /// A positive number of groups enables the large-scale mode for problems
+  /// with many parameters. In the style of cooperative coevolution, every
+  /// generation only varies the parameters of one group and cycles through
+  /// all groups. Problems modeling 'generic::grouped_problem' provide their
+  /// own groups. Otherwise, the parameters are randomly regrouped into the
+  /// given number of groups after every cycle. A positive number of mutated
+  /// parameters restricts every mutation to that many randomly chosen
+  /// parameters of the current group or, without groups, of all parameters.
+  /// For expensive objectives, a prescreening factor greater than one
+  /// generates that many candidates per offspring. Only the candidates whose
+  /// objectives, predicted by a surrogate model of all evaluated samples, are
+  /// most promising are evaluated. See 'prescreen'. The optimization stops
+  /// early if the budget is exhausted. See 'exhausted'.
   struct configuration {
     size_t iterations = 1000;
     size_t population = 1000;
     float kill_ratio = 0.5;
     float crossover_ratio = 0.3;
+    size_t threads = 1;
+    size_t sentinels = 0;
+    float change_tolerance = 0;
+    float diversity_ratio = 0.2;
+    sampling initialization = sampling::uniform;
+    size_t groups = 0;
+    size_t mutated_parameters = 0;
+    size_t prescreening = 0;
+    typename surrogate<real>::configuration model{};
+    pareto::budget budget{};
   };
 
   optimizer() = default;
   explicit optimizer(problem_type p,
                      generic::random_number_generator auto&& rng,
-                     configuration config = {})
-      : problem(p),
-        s(config.population),
-        select(std::floor((1 - config.kill_ratio) * config.population)),
-        iter(config.iterations),
-        crossover_probability(config.crossover_ratio) {
-    init();
+                     configuration config = {}) {
+    reset(p, std::forward<decltype(rng)>(rng), config);
+  }
+
+  /// Warm-starts the optimization by seeding the population with the samples
+  /// of the given frontier or optimizer. See 'init_population'.
+  explicit optimizer(problem_type p,
+                     generic::random_number_generator auto&& rng,
+                     const seed<real> auto& seeds,
+                     configuration config = {},
+                     bool reuse_objectives = false) {
+    reset(p, std::forward<decltype(rng)>(rng), seeds, config,
+          reuse_objectives);
+  }
+
+  /// Starts over with a new problem, configuration, and random population.
+  /// Already allocated memory is reused such that many small optimizations
+  /// can run one after another on the same instance.
+  void reset(problem_type p,
+             generic::random_number_generator auto&& rng,
+             configuration config = {}) {
+    configure(p, config);
     init_population(std::forward<decltype(rng)>(rng));
   }
 
+  /// Starts over with a new problem, configuration, and seeded population.
+  void reset(problem_type p,
+             generic::random_number_generator auto&& rng,
+             const seed<real> auto& seeds,
+             configuration config = {},
+             bool reuse_objectives = false) {
+    configure(p, config);
+    init_population(std::forward<decltype(rng)>(rng), seeds, reuse_objectives);
+  }
+
+  void configure(problem_type p, configuration config) {
+    problem = p;
+    s = config.population;
+    select = std::floor((1 - config.kill_ratio) * config.population);
+    iter = config.iterations;
+    crossover_probability = config.crossover_ratio;
+    threads = std::max<size_t>(1, config.threads);
+    scheduler = evaluation_scheduler{{.threads = threads}};
+    sentinels = std::min(config.sentinels, select);
+    change_tolerance = config.change_tolerance;
+    diversity = std::min<size_t>(config.diversity_ratio * s, select);
+    changes = 0;
+    generations = 0;
+    evaluations = 0;
+    cache_hits = 0;
+    delta_evaluations = 0;
+    low_fidelity_evaluations = 0;
+    samples = sampler<real>{config.initialization, problem.parameter_count()};
+    groups = config.groups;
+    mutated = config.mutated_parameters;
+    candidates = std::max<size_t>(1, config.prescreening);
+    model.reset(problem, config.model);
+    limits = config.budget;
+    progress = stagnation_detector<real>{limits};
+    init();
+  }
+
   void init() {
     const auto n = problem.parameter_count();
     const auto m = problem.objective_count();
-    parameters.resize(n * s);
-    objectives.resize(m * s);
+    // Additional candidates of the prescreening are stored after the
+    // population.
+    const auto size = s + (candidates - 1) * (s - select);
+    parameters.resize(n * size);
+    objectives.resize(m * size);
     permutation.resize(s);
     crowding_distances.resize(s);
-    pareto_indices.reserve(s);
+    ranks.resize(s);
+    insertions.reserve(s);
+    costs.assign(size, 0);
+    lineages.assign(size, {});
+    origins.resize(size);
+    marks.assign(n, false);
+    if constexpr (generic::multi_fidelity_problem<problem_type>) {
+      const auto levels = std::max<size_t>(1, problem.fidelity_count());
+      fidelity_objectives.resize((levels - 1) * m * s);
+      promotions.resize(s);
+      reset_biases();
+    }
+    init_groups();
+  }
+
+  /// Splits the parameters into the configured number of groups by storing
+  /// the parameter indices of one group after another. Grouped problems
+  /// define their groups themselves. Otherwise, contiguous blocks of
+  /// parameters are used until the first regrouping.
+  void init_groups() {
+    using namespace std;
+    const auto n = problem.parameter_count();
+    group = 0;
+    grouping.resize(n);
+    iota(grouping.begin(), grouping.end(), 0);
+    if (groups == 0) {
+      group_offsets.assign({0, n});
+      return;
+    }
+    if constexpr (generic::grouped_problem<problem_type>) {
+      // Counting sort of the parameters by their group
+      group_offsets.assign(problem.parameter_group_count() + 1, 0);
+      for (size_t i = 0; i < n; ++i)
+        ++group_offsets[problem.parameter_group(i) + 1];
+      partial_sum(group_offsets.begin(), group_offsets.end(),
+                  group_offsets.begin());
+      vector<size_t> next(group_offsets.begin(), group_offsets.end() - 1);
+      for (size_t i = 0; i < n; ++i)
+        grouping[next[problem.parameter_group(i)]++] = i;
+    } else {
+      const auto count = min(groups, n);
+      group_offsets.resize(count + 1);
+      for (size_t k = 0; k <= count; ++k)
+        group_offsets[k] = k * n / count;
+    }
   }
 
   /// Clamp the parameters referenced by the given index to the box constraints
@@ -94,116 +241,138 @@ class optimizer {
 
   /// Generates a random population to start with the optimization algorithm.
   void init_population(generic::random_number_generator auto&& rng) {
-    using namespace std;
+    randomize(0, rng);
+    evaluate_population(0);
+    sort_population();
+    calibrate_fidelities(0, s);
+    learn(0, s);
+  }
 
-    // Introduce short-hand notations.
+  /// Seeds the population with the samples of the given frontier and fills
+  /// the rest with random samples. If there are more samples than individuals,
+  /// evenly spaced samples are taken. Seeded parameters are clamped to the
+  /// box constraints of the current problem. If the problem did not change
+  /// since the samples have been computed, their stored objectives can be
+  /// reused to skip their evaluation.
+  void init_population(generic::random_number_generator auto&& rng,
+                       const generic::frontier auto& seeds,
+                       bool reuse_objectives = false) {
+    using namespace std;
     const auto n = problem.parameter_count();
     const auto m = problem.objective_count();
 
-    // Generate oracle for random numbers.
-    uniform_real_distribution<real> distribution{0, 1};
-    const auto random = [&] { return distribution(rng); };
+    if (seeds.sample_count() > 0 && seeds.parameter_count() != n)
+      throw invalid_argument(
+          "nsga2: seeds and problem differ in their parameter count");
+    if (reuse_objectives && seeds.sample_count() > 0 &&
+        seeds.objective_count() != m)
+      throw invalid_argument(
+          "nsga2: seeds and problem differ in their objective count");
+
+    const auto count = min(s, seeds.sample_count());
+    for (size_t i = 0; i < count; ++i) {
+      const auto k = i * seeds.sample_count() / count;
+      copy_n(seeds.parameters_iterator(k), n, &parameters[n * i]);
+      if (reuse_objectives)
+        copy_n(seeds.objectives_iterator(k), m, &objectives[m * i]);
+      clamp(i);
+    }
+    randomize(count, rng);
+    evaluate_population(reuse_objectives ? count : 0);
+    sort_population();
+    calibrate_fidelities(0, s);
+    learn(0, s);
+  }
 
-    // Iterate over all possible samples.
-    for (size_t i = 0; i < s; ++i) {
-      // Generate uniformly distributed parameter samples.
-      for (size_t j = 0; j < n; ++j)
-        parameters[n * i + j] =
-            lerp(problem.box_min(j), problem.box_max(j), random());
-      evaluate(i);
+  /// Seeds the population with the Pareto frontier estimated by another
+  /// optimizer, like the naive one.
+  void init_population(
+      generic::random_number_generator auto&& rng,
+      const generic::frontier_castable<frontier<real>> auto& source,
+      bool reuse_objectives = false) {
+    init_population(std::forward<decltype(rng)>(rng),
+                    pareto::frontier_cast<frontier<real>>(source),
+                    reuse_objectives);
+  }
+
+  /// Fills the population beginning at the given index with samples of the
+  /// configured sampling method.
+  void randomize(size_t first, generic::random_number_generator auto&& rng) {
+    const auto n = problem.parameter_count();
+    samples.sample(problem, s - first, &parameters[n * first], rng);
+  }
+
+  /// Evaluates the population beginning at the given index.
+  void evaluate_population(size_t first) {
+    LYRAHGAMES_PARETO_TRACE_SCOPE("nsga2::evaluate_population");
+    using namespace std;
+    const auto n = problem.parameter_count();
+    const auto m = problem.objective_count();
+    if (first >= s) return;
+    evaluations += s - first;
+    // The population is already stored contiguously.
+    if constexpr (generic::batch_evaluatable_problem<problem_type>) {
+      problem.evaluate_batch(
+          span<const real>{&parameters[n * first], n * (s - first)},
+          span<real>{&objectives[m * first], m * (s - first)});
+    } else if (threads > 1) {
+      // Nothing is known about the costs of the initial population.
+      scheduler.run(
+          s - first, [&](size_t, size_t i) { evaluate(first + i); }, {},
+          span{&costs[first], s - first});
+    } else {
+      for (size_t i = first; i < s; ++i)
+        evaluate(i);
     }
+  }
 
-    // Pre-sort the randomly generated population.
+  /// Sorts a new population from scratch.
+  void sort_population() {
+    ranks.resize(s);
     non_dominated_sort();
     crowding_distance_sort();
   }
 
-  /// Sort the current population into their layers of domination.
+  /// Sort the current population into their layers of domination. Only points
+  /// that are not ranked yet, like offspring, are inserted into the persistent
+  /// layers. Afterwards, the layers are written to the permutation such that
+  /// the best layers are stored at its end. The elements of the 'fronts' array
+  /// mark the beginning of a new layer until at least 'select' points have
+  /// been reached.
   void non_dominated_sort() {
+    LYRAHGAMES_PARETO_TRACE_SCOPE("nsga2::non_dominated_sort");
     using namespace std;
-
-    const auto n = problem.parameter_count();
     const auto m = problem.objective_count();
 
-    // We use a permutation array to not have to copy all vectors.
-    iota(permutation.begin(), permutation.end(), 0);
-
-    // The elements of the fronts array mark the beginning of a new pareto front
-    // beginning from the end with respect to the permutation.
-    fronts.resize(1);
-    fronts[0] = 0;
-
-    // Sort front-wise until enough points are reached.
-    while (fronts.back() < select) {
-      pareto_indices.clear();
-      pareto_indices.insert(permutation[0]);
-
-      // Marks the number of currently dominated points.
-      size_t front = 0;
-
-      // Already known pareto points have already been put at the end.
-      // So iterate only over dominated points from the last iteration.
-      for (size_t i = 1; i < s - fronts.back(); ++i) {
-        // Reference the objectives of the current point with respect to the
-        // permutation.
-        const auto index = permutation[i];
-        auto p = span{&objectives[m * index], &objectives[m * (index + 1)]};
-
-        // Check this point for domination against all other points currently
-        // assumed to be Pareto points.
-        bool non_dominated = true;
-        auto it = begin(pareto_indices);
-        for (; it != end(pareto_indices);) {
-          // Reference the objectives of an assumed Pareto point.
-          const auto j = *it;
-          auto q = span{&objectives[m * j], &objectives[m * (j + 1)]};
-
-          // Every dominated point will be put in the permutation front.
-          // At the end, all pareto points will be put at the end of the current
-          // permutation.
-
-          // If the current point is dominated by the assumed Pareto point then
-          // put it at the front of the permutation.
-          if (dominates(q, p)) {
-            non_dominated = false;
-            permutation[front] = index;
-            ++front;
-            break;
-          }
-
-          // If it dominates other assumed Pareto points then remove the assumed
-          // Pareto point and put its index at the front of the permutation.
-          if (dominates(p, q)) {
-            it = pareto_indices.erase(it);
-            permutation[front] = j;
-            ++front;
-          } else {
-            ++it;
-          }
-        }
-
-        if (non_dominated) pareto_indices.insert(index);
-      }
-
-      // Order dominated points in reverse order. Heuristic to fasten up
-      // sorting. Apart from performance, there is no logical reason to do this.
-      // The algorithm would be able to work without it.
-      for (size_t i = 0; i < front / 2; ++i)
-        swap(permutation[i], permutation[front - 1 - i]);
-
-      // Put all Pareto points after the dominated points.
-      for (auto j : pareto_indices) {
-        permutation[front] = j;
-        ++front;
-      }
-      // Mark the current front.
-      fronts.push_back(fronts.back() + pareto_indices.size());
+    // In lexicographical order, no inserted point dominates a point inserted
+    // before. For the initial population, no layer has to be changed at all.
+    insertions.clear();
+    for (size_t i = 0; i < s; ++i)
+      if (!ranks.contains(i)) insertions.push_back(i);
+    sort(insertions.begin(), insertions.end(), [&](auto i, auto j) {
+      return lexicographical_compare(&objectives[m * i],
+                                     &objectives[m * (i + 1)],
+                                     &objectives[m * j],
+                                     &objectives[m * (j + 1)]);
+    });
+    for (auto i : insertions)
+      ranks.insert(objectives.data(), m, i);
+
+    // Worse layers are put in front such that the worst points come first.
+    fronts.assign(1, 0);
+    auto it = permutation.end();
+    for (size_t k = 0; k < ranks.front_count(); ++k) {
+      const auto& front = ranks.front(k);
+      it = copy_backward(front.begin(), front.end(), it);
+      if (fronts.back() < select)
+        fronts.push_back(fronts.back() + front.size());
     }
   }
 
   /// Sort a specific domination layer of the current population with respect to
   /// their crowding distance by computing it first.
   void crowding_distance_sort() {
+    LYRAHGAMES_PARETO_TRACE_SCOPE("nsga2::crowding_distance_sort");
     using namespace std;
 
     const auto n = problem.parameter_count();
@@ -220,7 +389,7 @@ class optimizer {
     // Set used crowding distances to zero to able to accumulate afterwards.
     // for (size_t i = offset; i < offset + count; ++i)
     for (size_t i = first; i < last; ++i)
-      crowding_distances[i] = 0;
+      crowding_distances[permutation[i]] = 0;
 
     // Compute the crowding distance for every point
     // by iterating over all objectives.
@@ -260,64 +429,139 @@ class optimizer {
                                   size_t offspring1,
                                   size_t offspring2,
                                   generic::random_number_generator auto&& rng) {
-    using namespace std;
-
     const auto n = problem.parameter_count();
-    const auto m = problem.objective_count();
-
-    constexpr real distribution_index = 2;
-    constexpr auto distribution_index_coeff = 1 / (distribution_index + 1);
-
-    uniform_real_distribution<real> distribution{0, 1};
-
-    for (size_t i = 0; i < n; ++i) {
-      const auto random = distribution(rng);
-      const auto beta =
-          (random <= real(0.5))
-              ? (pow(2 * random, distribution_index_coeff))
-              : (pow(1 / (2 * (1 - random)), distribution_index_coeff));
-
-      const auto tmp1 = real(0.5) * ((1 + beta) * parameters[n * parent1 + i] +
-                                     (1 - beta) * parameters[n * parent2 + i]);
-
-      const auto tmp2 = real(0.5) * ((1 - beta) * parameters[n * parent1 + i] +
-                                     (1 + beta) * parameters[n * parent2 + i]);
-
-      parameters[n * offspring1 + i] = tmp1;
-      parameters[n * offspring2 + i] = tmp2;
-    }
+    pareto::simulated_binary_crossover(
+        n, &parameters[n * parent1], &parameters[n * parent2],
+        &parameters[n * offspring1], &parameters[n * offspring2], rng);
   }
 
   /// Mutation Scheme
   void alternate_random_mutation(size_t parent,
                                  size_t offspring,
                                  generic::random_number_generator auto&& rng) {
+    const auto n = problem.parameter_count();
+    pareto::alternate_random_mutation(problem, &parameters[n * parent],
+                                      &parameters[n * offspring], rng);
+  }
+
+  /// Crossover of the large-scale mode that only changes the parameters of
+  /// the current group. All other parameters are copied from the parents.
+  void grouped_crossover(size_t parent1,
+                         size_t parent2,
+                         size_t offspring1,
+                         size_t offspring2,
+                         std::span<const size_t> variables,
+                         generic::random_number_generator auto&& rng) {
     using namespace std;
+    const auto n = problem.parameter_count();
+    copy_n(&parameters[n * parent1], n, &parameters[n * offspring1]);
+    copy_n(&parameters[n * parent2], n, &parameters[n * offspring2]);
+    pareto::simulated_binary_crossover(
+        variables, &parameters[n * parent1], &parameters[n * parent2],
+        &parameters[n * offspring1], &parameters[n * offspring2], rng);
+    track(offspring1, parent1, variables);
+    track(offspring2, parent2, variables);
+  }
 
-    // Introduce short-hand notations.
+  /// Mutation of the large-scale mode that only changes the given variables
+  /// or, if configured, a random subset of them. All other parameters are
+  /// copied from the parent.
+  void sparse_mutation(size_t parent,
+                       size_t offspring,
+                       std::span<const size_t> variables,
+                       generic::random_number_generator auto&& rng) {
+    using namespace std;
     const auto n = problem.parameter_count();
-    const auto m = problem.objective_count();
+    copy_n(&parameters[n * parent], n, &parameters[n * offspring]);
+    const auto first = changed.size();
+    if (mutated == 0 || mutated >= variables.size())
+      changed.insert(changed.end(), variables.begin(), variables.end());
+    else {
+      // Floyd's algorithm chooses distinct variables in linear time.
+      const auto size = variables.size();
+      for (size_t j = size - mutated; j < size; ++j) {
+        auto k = uniform_int_distribution<size_t>{0, j}(rng);
+        if (marks[variables[k]]) k = j;
+        marks[variables[k]] = true;
+        changed.push_back(variables[k]);
+      }
+      // Sorted indices keep the accesses to the parameters ascending.
+      sort(changed.begin() + first, changed.end());
+      for (auto i = first; i < changed.size(); ++i)
+        marks[changed[i]] = false;
+    }
+    lineages[offspring] = {parent, first, changed.size()};
+    pareto::alternate_random_mutation(problem, changed_parameters(offspring),
+                                      &parameters[n * parent],
+                                      &parameters[n * offspring], rng);
+  }
 
-    constexpr real stepsize = 0.1;
+  /// Clamps the parameters of the given offspring to the box constraints. In
+  /// the large-scale mode, only its changed parameters have to be clamped.
+  void clamp_offspring(size_t index) {
+    using std::clamp;
+    if (!lineages[index].tracked()) {
+      this->clamp(index);
+      return;
+    }
+    const auto n = problem.parameter_count();
+    for (auto i : changed_parameters(index))
+      parameters[n * index + i] = clamp(parameters[n * index + i],
+                                        problem.box_min(i), problem.box_max(i));
+  }
 
-    // Construct oracle for random numbers.
-    uniform_real_distribution<real> distribution{-1, 1};
-    const auto uniform = [&] { return distribution(rng); };
+  /// Stores that the given offspring only differs from the given parent in
+  /// the given parameters.
+  void track(size_t offspring, size_t parent, std::span<const size_t> x) {
+    const auto first = changed.size();
+    changed.insert(changed.end(), x.begin(), x.end());
+    lineages[offspring] = {parent, first, changed.size()};
+  }
 
-    // For all parameters of the parent, draw new parameters.
-    for (size_t k = 0; k < n; ++k) {
-      const auto random = uniform();
-      const auto a = problem.box_min(k);
-      const auto b = problem.box_max(k);
-      const auto value =
-          parameters[n * parent + k] + random * stepsize * (b - a);
-      parameters[n * offspring + k] = value;
-    }
+  /// Returns the indices of the parameters in which the given offspring of
+  /// the large-scale mode differs from its parent.
+  std::span<const size_t> changed_parameters(size_t offspring) const noexcept {
+    const auto& l = lineages[offspring];
+    return {changed.data() + l.first, l.last - l.first};
+  }
+
+  /// Advances to the next non-empty group of the large-scale mode and returns
+  /// the indices of its parameters. At the start of every cycle, randomly
+  /// grouped parameters are regrouped. The indices of every group are sorted
+  /// such that they are accessed in ascending order.
+  std::span<const size_t> next_group(
+      generic::random_number_generator auto&& rng) {
+    using namespace std;
+    const auto count = group_offsets.size() - 1;
+    size_t first, last;
+    do {
+      if constexpr (!generic::grouped_problem<problem_type>) {
+        if (group == 0) {
+          shuffle(grouping.begin(), grouping.end(), rng);
+          for (size_t k = 0; k < count; ++k)
+            sort(grouping.begin() + group_offsets[k],
+                 grouping.begin() + group_offsets[k + 1]);
+        }
+      }
+      first = group_offsets[group];
+      last = group_offsets[group + 1];
+      group = (group + 1) % count;
+    } while (first == last);
+    return {grouping.data() + first, last - first};
   }
 
   /// Discards the bad part of the population and fills it up again by using
   /// crossovers and mutations.
   void populate(generic::random_number_generator auto&& rng) {
+    vary(rng);
+    evaluate_offspring();
+  }
+
+  /// Replaces the discarded part of the population by offspring without
+  /// evaluating them. Offspring identical to one of their parents reuse its
+  /// objectives and are moved to the front of the permutation.
+  void vary(generic::random_number_generator auto&& rng) {
+    LYRAHGAMES_PARETO_TRACE_SCOPE("nsga2::vary");
     using namespace std;
 
     // Introduce short-hand notations.
@@ -329,56 +573,741 @@ class optimizer {
     uniform_int_distribution<size_t> distribution{s - select, s - 1};
     const auto random = [&] { return distribution(rng); };
 
-    // Compute count of crossovers.
+    // Compute count of crossovers. With prescreening, more candidates than
+    // offspring are generated. The first ones are stored in the slots of the
+    // offspring and all others after the population.
     const size_t count = s - select;
+    const size_t total = candidates * count;
     const size_t crossover_count =
-        2 * size_t(crossover_probability * (count / 2));
+        2 * size_t(crossover_probability * (total / 2));
+    const auto candidate = [&](size_t i) {
+      return (i < count) ? permutation[i] : s + i - count;
+    };
+
+    // Discarded points have to leave their layers before their objectives are
+    // overwritten. They are ordered from worst to best such that no other
+    // point changes its layer. After a change, all layers have been dropped.
+    for (size_t i = 0; i < count; ++i)
+      if (ranks.contains(permutation[i]))
+        ranks.remove(objectives.data(), m, permutation[i]);
+
+    // In the large-scale mode, offspring only differ from their parents in
+    // the parameters of the current group or the mutated ones.
+    changed.clear();
+    for (size_t k = 0; k < count; ++k)
+      lineages[permutation[k]] = {};
+    fill(lineages.begin() + s, lineages.end(), lineage{});
+    const auto variables =
+        (groups > 0) ? next_group(rng) : span<const size_t>{grouping};
 
     size_t i = 0;
+    hits = 0;
 
     // Crossover
     for (; i < crossover_count; i += 2) {
       const auto parent1 = permutation[random()];
       const auto parent2 = permutation[random()];
-      const auto offspring1 = permutation[i + 0];
-      const auto offspring2 = permutation[i + 1];
-
-      simulated_binary_crossover(parent1, parent2, offspring1, offspring2, rng);
+      const auto offspring1 = candidate(i + 0);
+      const auto offspring2 = candidate(i + 1);
+
+      if (groups > 0)
+        grouped_crossover(parent1, parent2, offspring1, offspring2, variables,
+                          rng);
+      else
+        simulated_binary_crossover(parent1, parent2, offspring1, offspring2,
+                                   rng);
+      // Offspring are expected to be as expensive as their parents.
+      costs[offspring1] = costs[offspring2] =
+          (costs[parent1] + costs[parent2]) / 2;
       // Make sure newly generated parameters fulfill the box constraints.
-      clamp(offspring1);
-      clamp(offspring2);
-      evaluate(offspring1);
-      evaluate(offspring2);
+      clamp_offspring(offspring1);
+      clamp_offspring(offspring2);
+      if (candidates > 1) {
+        // Caches are checked after the prescreening.
+        origins[offspring1] = origins[offspring2] = {parent1, parent2};
+        continue;
+      }
+      if (!cached(i, parent1) && !cached(i, parent2)) submit(offspring1);
+      if (!cached(i + 1, parent1) && !cached(i + 1, parent2))
+        submit(offspring2);
     }
 
     // Mutation
-    for (; i < count; ++i) {
+    for (; i < total; ++i) {
       const auto parent = permutation[random()];
-      const auto offspring = permutation[i];
+      const auto offspring = candidate(i);
 
-      alternate_random_mutation(parent, offspring, rng);
+      if (groups > 0 || mutated > 0)
+        sparse_mutation(parent, offspring, variables, rng);
+      else
+        alternate_random_mutation(parent, offspring, rng);
+      costs[offspring] = costs[parent];
       // Make sure newly generated parameters fulfill the box constraints.
-      clamp(offspring);
-      evaluate(offspring);
+      clamp_offspring(offspring);
+      if (candidates > 1)
+        origins[offspring] = {parent, parent};
+      else if (!cached(i, parent))
+        submit(offspring);
+    }
+
+    if (candidates > 1) {
+      prescreen(count);
+      for (i = 0; i < count; ++i) {
+        const auto [parent1, parent2] = origins[permutation[i]];
+        if (cached(i, parent1)) continue;
+        if (parent1 != parent2 && cached(i, parent2)) continue;
+        submit(permutation[i]);
+      }
     }
+    cache_hits += hits;
   }
 
+  /// Moves the most promising candidates of the prescreening into the slots
+  /// of the offspring. The objectives of all candidates are predicted by the
+  /// surrogate model. Candidates are ranked by the number of survivors and
+  /// other candidates whose objectives dominate their predicted ones. Ties
+  /// are broken in favor of candidates that dominate more points.
+  void prescreen(size_t count) {
+    LYRAHGAMES_PARETO_TRACE_SCOPE("nsga2::prescreen");
+    using namespace std;
+    const auto n = problem.parameter_count();
+    const auto m = problem.objective_count();
+    const auto total = candidates * count;
+    const auto candidate = [&](size_t i) {
+      return (i < count) ? permutation[i] : s + i - count;
+    };
+    const auto point = [&](size_t index) {
+      return span<const real>{&objectives[m * index], m};
+    };
+
+    for (size_t i = 0; i < total; ++i) {
+      const auto index = candidate(i);
+      model.predict(&parameters[n * index], &objectives[m * index]);
+    }
+
+    // Smaller scores are better. Domination by others outweighs every number
+    // of dominated points.
+    const auto weight = ptrdiff_t(select + total);
+    scores.assign(total, 0);
+    for (size_t i = 0; i < total; ++i) {
+      const auto y = point(candidate(i));
+      const auto compare = [&](size_t index) {
+        if (dominates(point(index), y))
+          scores[i] += weight;
+        else if (dominates(y, point(index)))
+          --scores[i];
+      };
+      for (auto k = s - select; k < s; ++k)
+        compare(permutation[k]);
+      for (size_t j = 0; j < total; ++j)
+        if (j != i) compare(candidate(j));
+    }
+    ranking.resize(total);
+    iota(ranking.begin(), ranking.end(), 0);
+    nth_element(ranking.begin(), ranking.begin() + count, ranking.end(),
+                [&](auto i, auto j) { return scores[i] < scores[j]; });
+
+    // Every chosen candidate stored after the population takes the slot of a
+    // rejected candidate stored in the slots of the offspring.
+    auto rejected = ranking.begin() + count;
+    for (auto it = ranking.begin(); it != ranking.begin() + count; ++it) {
+      if (*it < count) continue;
+      while (*rejected >= count)
+        ++rejected;
+      exchange(candidate(*rejected++), candidate(*it));
+    }
+  }
+
+  /// Swaps the parameters and the generation data of two candidates.
+  void exchange(size_t a, size_t b) {
+    using namespace std;
+    const auto n = problem.parameter_count();
+    swap_ranges(parameters.begin() + n * a, parameters.begin() + n * (a + 1),
+                parameters.begin() + n * b);
+    swap(lineages[a], lineages[b]);
+    swap(costs[a], costs[b]);
+    swap(origins[a], origins[b]);
+  }
+
+  /// Adds the evaluated individuals referenced by the elements of the
+  /// permutation in the range [first, last) to the history of the surrogate
+  /// model. Without prescreening, no model is needed.
+  void learn(size_t first, size_t last) {
+    const auto n = problem.parameter_count();
+    const auto m = problem.objective_count();
+    if (candidates < 2) return;
+    for (auto i = first; i < last; ++i) {
+      const auto index = permutation[i];
+      model.insert(&parameters[n * index], &objectives[m * index]);
+    }
+  }
+
+  /// Reuses the objectives of the given parent if the offspring at the given
+  /// position of the permutation has identical parameters, like after both
+  /// have been clamped to the same corner of the box. Such offspring are
+  /// swapped to the front of the permutation to skip their evaluation.
+  bool cached(size_t position, size_t parent) {
+    using namespace std;
+    const auto n = problem.parameter_count();
+    const auto m = problem.objective_count();
+    const auto offspring = permutation[position];
+    if (lineages[offspring].tracked()) {
+      // Offspring of the large-scale mode are only compared to the parent
+      // they have been copied from and only in their changed parameters.
+      if (lineages[offspring].parent != parent) return false;
+      for (auto i : changed_parameters(offspring))
+        if (parameters[n * parent + i] != parameters[n * offspring + i])
+          return false;
+    } else if (!equal(&parameters[n * parent], &parameters[n * (parent + 1)],
+                      &parameters[n * offspring]))
+      return false;
+    copy_n(&objectives[m * parent], m, &objectives[m * offspring]);
+    swap(permutation[position], permutation[hits++]);
+    return true;
+  }
+
+  /// Hands the offspring at the given index over to an asynchronously
+  /// evaluating problem such that its evaluation overlaps with the generation
+  /// of further offspring. For all other problems, nothing happens.
+  void submit(size_t index) {
+    using std::span;
+    if constexpr (generic::asynchronously_evaluatable_problem<problem_type>) {
+      const auto n = problem.parameter_count();
+      const auto m = problem.objective_count();
+      problem.submit(span<const real>{&parameters[n * index], n},
+                     span<real>{&objectives[m * index], m});
+    }
+  }
+
+  /// Evaluates the offspring generated by 'vary' that are not cached.
+  /// Asynchronously evaluated offspring have already been submitted and only
+  /// need to be waited for. Offspring of the large-scale mode are updated
+  /// from their parents if the problem supports it. If the problem supports
+  /// batch evaluation, their parameters are gathered to evaluate all of them
+  /// in one call. Otherwise, offspring are distributed over the threads by
+  /// the evaluation scheduler with their predicted costs, which are replaced
+  /// by the measured ones afterwards. Problems with several levels of
+  /// fidelity only evaluate offspring at the highest level that have been
+  /// promoted by 'filter_fidelities'. Promoted offspring of the large-scale
+  /// mode are still updated from their parents. With prescreening, the
+  /// evaluated offspring extend the history of the surrogate model.
+  void evaluate_offspring() {
+    LYRAHGAMES_PARETO_TRACE_SCOPE("nsga2::evaluate_offspring");
+    auto first = hits;
+    if constexpr (generic::asynchronously_evaluatable_problem<problem_type>) {
+      problem.wait();
+      evaluations += s - select - hits;
+    } else if constexpr (generic::multi_fidelity_problem<problem_type>) {
+      first = filter_fidelities(hits, s - select);
+      if constexpr (generic::delta_evaluatable_problem<problem_type>)
+        evaluate_permutation(evaluate_deltas(first, s - select), s - select);
+      else
+        evaluate_permutation(first, s - select);
+      update_biases(first, s - select);
+    } else if constexpr (generic::delta_evaluatable_problem<problem_type>)
+      evaluate_permutation(evaluate_deltas(hits, s - select), s - select);
+    else
+      evaluate_permutation(hits, s - select);
+    learn(first, s - select);
+  }
+
+  /// Promotes the offspring referenced by the elements of the permutation in
+  /// the range [first, last) through the levels of fidelity below the
+  /// highest one. At every level, the remaining offspring are evaluated and
+  /// their objectives are corrected by the estimated bias of the level. Only
+  /// offspring that would survive the selection with these objectives are
+  /// promoted to the next level. All others get infinite objectives such
+  /// that they are discarded by the next selection and are swapped to the
+  /// front of the range. The position of the first offspring that has to be
+  /// evaluated at the highest level is returned.
+  size_t filter_fidelities(size_t first, size_t last) {
+    LYRAHGAMES_PARETO_TRACE_SCOPE("nsga2::filter_fidelities");
+    const auto m = problem.objective_count();
+    const auto levels = problem.fidelity_count();
+    for (size_t level = 0; level + 1 < levels && first < last; ++level) {
+      evaluate_fidelity(first, last, level);
+      for (auto i = first; i < last; ++i) {
+        const auto index = permutation[i];
+        for (size_t j = 0; j < m; ++j)
+          objectives[m * index + j] =
+              fidelity_objectives[m * (s * level + index) + j] +
+              bias(level, j);
+      }
+      first = promote(first, last);
+    }
+    return first;
+  }
+
+  /// Sorts the population with the current objectives of the offspring to
+  /// find the offspring in the range [first, last) of the permutation that
+  /// would survive. Afterwards, the offspring leave the domination layers
+  /// again and the permutation is restored. Offspring that would not survive
+  /// are handled as described in 'filter_fidelities'.
+  size_t promote(size_t first, size_t last) {
+    using namespace std;
+    const auto m = problem.objective_count();
+    previous_permutation.assign(permutation.begin(), permutation.end());
+    non_dominated_sort();
+    crowding_distance_sort();
+    fill(promotions.begin(), promotions.end(), false);
+    for (auto i = s - select; i < s; ++i)
+      promotions[permutation[i]] = true;
+    // Removing the worst points first keeps all other points in their layers.
+    sort(insertions.begin(), insertions.end(),
+         [&](auto i, auto j) { return ranks.rank(i) > ranks.rank(j); });
+    for (auto i : insertions)
+      ranks.remove(objectives.data(), m, i);
+    permutation.swap(previous_permutation);
+
+    for (auto i = first; i < last; ++i) {
+      const auto index = permutation[i];
+      if (promotions[index]) continue;
+      discard(index);
+      swap(permutation[i], permutation[first++]);
+    }
+    return first;
+  }
+
+  /// Evaluates the individuals referenced by the elements of the permutation
+  /// in the range [first, last) at the given level of fidelity below the
+  /// highest one. Their objectives are stored separately for every level.
+  void evaluate_fidelity(size_t first, size_t last, size_t level) {
+    using namespace std;
+    if constexpr (generic::multi_fidelity_problem<problem_type>) {
+      const auto n = problem.parameter_count();
+      const auto m = problem.objective_count();
+      const auto count = last - first;
+      const auto task = [&](size_t, size_t i) {
+        const auto index = permutation[first + i];
+        problem.evaluate(
+            span<const real>{&parameters[n * index], n},
+            span<real>{&fidelity_objectives[m * (s * level + index)], m},
+            level);
+      };
+      low_fidelity_evaluations += count;
+      if (threads > 1)
+        scheduler.run(count, task);
+      else
+        for (size_t i = 0; i < count; ++i)
+          task(0, i);
+    }
+  }
+
+  /// Evaluates the individuals referenced by the elements of the permutation
+  /// in the range [first, last), whose objectives are known at the highest
+  /// level of fidelity, at all lower levels to estimate their biases.
+  void calibrate_fidelities(size_t first, size_t last) {
+    if constexpr (generic::multi_fidelity_problem<problem_type>) {
+      for (size_t level = 0; level + 1 < problem.fidelity_count(); ++level)
+        evaluate_fidelity(first, last, level);
+      update_biases(first, last);
+    }
+  }
+
+  /// Adds the differences between the objectives at the highest level and
+  /// all lower levels of fidelity of the individuals referenced by the
+  /// elements of the permutation in the range [first, last) to the bias
+  /// estimates. The bias of a level is the mean of all its differences.
+  void update_biases(size_t first, size_t last) {
+    const auto m = problem.objective_count();
+    const auto levels = bias_sums.size() / m;
+    for (auto i = first; i < last; ++i) {
+      const auto index = permutation[i];
+      for (size_t level = 0; level < levels; ++level)
+        for (size_t j = 0; j < m; ++j)
+          bias_sums[m * level + j] +=
+              objectives[m * index + j] -
+              fidelity_objectives[m * (s * level + index) + j];
+    }
+    bias_samples += last - first;
+  }
+
+  /// Forgets all differences between the levels of fidelity.
+  void reset_biases() {
+    if constexpr (generic::multi_fidelity_problem<problem_type>) {
+      const auto levels = std::max<size_t>(1, problem.fidelity_count());
+      bias_sums.assign((levels - 1) * problem.objective_count(), 0);
+      bias_samples = 0;
+    }
+  }
+
+  /// Returns the estimated bias of the given objective at the given level of
+  /// fidelity that has to be added to reach the highest level.
+  real bias(size_t level, size_t j) const noexcept {
+    const auto m = problem.objective_count();
+    return bias_samples ? bias_sums[m * level + j] / bias_samples : real(0);
+  }
+
+  /// Updates the objectives of the offspring referenced by the elements of
+  /// the permutation in the range [first, last) by the problem's delta
+  /// evaluation if they differ from their parent in at most half of the
+  /// parameters. Parents survive the generation such that their objectives
+  /// are still valid. Updated offspring are swapped to the front of the range
+  /// and the position of the first offspring that still has to be evaluated
+  /// is returned. No update is started after the budget has been exhausted.
+  size_t evaluate_deltas(size_t first, size_t last) {
+    using namespace std;
+    const auto n = problem.parameter_count();
+    const auto m = problem.objective_count();
+    for (auto i = first; i < last; ++i) {
+      if (limits.remaining(evaluations) == 0 || limits.expired()) break;
+      const auto offspring = permutation[i];
+      const auto& l = lineages[offspring];
+      if (!l.tracked() || 2 * (l.last - l.first) > n) continue;
+      problem.evaluate_delta(span<const real>{&parameters[n * l.parent], n},
+                             span<const real>{&objectives[m * l.parent], m},
+                             changed_parameters(offspring),
+                             span<const real>{&parameters[n * offspring], n},
+                             span<real>{&objectives[m * offspring], m});
+      swap(permutation[i], permutation[first++]);
+      ++evaluations;
+      ++delta_evaluations;
+    }
+    return first;
+  }
+
+  /// Evaluates the individuals referenced by the elements of the permutation
+  /// in the range [first, last). Individuals beyond the evaluation budget and
+  /// individuals whose evaluation would start after the deadline are
+  /// discarded. Batches are evaluated as a whole.
+  void evaluate_permutation(size_t first, size_t last) {
+    using namespace std;
+    const auto m = problem.objective_count();
+    const auto count = min(last - first, limits.remaining(evaluations));
+    const auto index = [&](size_t i) { return permutation[first + i]; };
+    for (auto i = count; i < last - first; ++i)
+      discard(index(i));
+    evaluations += count;
+    evaluations -= evaluate_individuals(
+        count, index, [&](size_t i) { return &objectives[m * index(i)]; },
+        [&](size_t i) { discard(index(i)); });
+  }
+
+  /// Evaluates the individuals with the indices 'index(i)' for all 'i' in
+  /// [0, count) and writes their objectives to 'y(i)'. Asynchronous problems
+  /// get all samples submitted before waiting for them. Batch problems get
+  /// all parameters gathered into one call. Otherwise, the individuals are
+  /// distributed over the threads by the evaluation scheduler with their
+  /// predicted costs, which are replaced by the measured ones afterwards.
+  /// Evaluations that would start after the deadline are skipped and passed
+  /// to 'skip(i)'. Returns the number of skipped evaluations.
+  size_t evaluate_individuals(size_t count,
+                              const auto& index,
+                              const auto& y,
+                              const auto& skip) {
+    using namespace std;
+    const auto n = problem.parameter_count();
+    const auto m = problem.objective_count();
+    const auto x = [&](size_t i) {
+      return span<const real>{&parameters[n * index(i)], n};
+    };
+    size_t skipped = 0;
+    if constexpr (generic::asynchronously_evaluatable_problem<problem_type>) {
+      for (size_t i = 0; i < count; ++i) {
+        if (limits.expired()) {
+          skip(i);
+          ++skipped;
+        } else
+          problem.submit(x(i), span<real>{y(i), m});
+      }
+      problem.wait();
+    } else if constexpr (generic::batch_evaluatable_problem<problem_type>) {
+      if (limits.expired()) {
+        for (size_t i = 0; i < count; ++i)
+          skip(i);
+        return count;
+      }
+      batch_parameters.resize(n * count);
+      batch_objectives.resize(m * count);
+      for (size_t i = 0; i < count; ++i)
+        copy_n(x(i).data(), n, &batch_parameters[n * i]);
+      problem.evaluate_batch(span<const real>{batch_parameters},
+                             span<real>{batch_objectives});
+      for (size_t i = 0; i < count; ++i)
+        copy_n(&batch_objectives[m * i], m, y(i));
+    } else if (threads > 1) {
+      predictions.resize(count);
+      durations.resize(count);
+      for (size_t i = 0; i < count; ++i)
+        predictions[i] = costs[index(i)];
+      atomic<size_t> missed = 0;
+      scheduler.run(
+          count,
+          [&](size_t, size_t i) {
+            if (!limits.expired())
+              return problem.evaluate(x(i), span<real>{y(i), m});
+            skip(i);
+            ++missed;
+          },
+          predictions, durations);
+      for (size_t i = 0; i < count; ++i)
+        costs[index(i)] = durations[i];
+      skipped = missed;
+    } else {
+      for (size_t i = 0; i < count; ++i) {
+        if (limits.expired()) {
+          skip(i);
+          ++skipped;
+        } else
+          problem.evaluate(x(i), span<real>{y(i), m});
+      }
+    }
+    return skipped;
+  }
+
+  /// Gives the individual at the given index infinite objectives such that it
+  /// is discarded by the next selection.
+  void discard(size_t index) {
+    const auto m = problem.objective_count();
+    std::fill_n(&objectives[m * index], m,
+                std::numeric_limits<real>::infinity());
+  }
+
+  /// Re-evaluates a few distinct, randomly chosen surviving individuals, the
+  /// sentinels, and returns true if any of their objectives deviate from the
+  /// stored ones by more than the tolerance relative to their magnitude.
+  /// Sentinels are evaluated like offspring. Sentinels that are skipped
+  /// because of the deadline keep their stored objectives. After the
+  /// deadline, no sentinel is checked at all.
+  bool detect_change(generic::random_number_generator auto&& rng) {
+    LYRAHGAMES_PARETO_TRACE_SCOPE("nsga2::detect_change");
+    using namespace std;
+    if (limits.expired()) return false;
+    const auto m = problem.objective_count();
+    const auto count = min(sentinels, limits.remaining(evaluations));
+
+    // Draw distinct survivors by a partial Fisher-Yates shuffle.
+    sentinel_indices.assign(permutation.begin() + (s - select),
+                            permutation.end());
+    for (size_t i = 0; i < count; ++i)
+      swap(sentinel_indices[i],
+           sentinel_indices[uniform_int_distribution<size_t>{
+               i, sentinel_indices.size() - 1}(rng)]);
+
+    sentinel_objectives.resize(m * count);
+    for (size_t i = 0; i < count; ++i)
+      copy_n(&objectives[m * sentinel_indices[i]], m,
+             &sentinel_objectives[m * i]);
+    evaluations += count;
+    evaluations -= evaluate_individuals(
+        count, [&](size_t i) { return sentinel_indices[i]; },
+        [&](size_t i) { return &sentinel_objectives[m * i]; }, [](size_t) {});
+
+    for (size_t i = 0; i < count; ++i) {
+      for (size_t j = 0; j < m; ++j) {
+        const auto old = objectives[m * sentinel_indices[i] + j];
+        if (abs(sentinel_objectives[m * i + j] - old) >
+            change_tolerance * max(real(1), abs(old)))
+          return true;
+      }
+    }
+    return false;
+  }
+
+  /// Adapts the population to changed objectives. The worst surviving
+  /// individuals are replaced by new samples to regain diversity. All
+  /// other survivors keep their parameters and are re-evaluated. Discarded
+  /// individuals are not evaluated again because they are replaced by the
+  /// next offspring. As all objectives may have changed, the domination
+  /// layers are built from scratch during the next sort. Survivors are never
+  /// discarded. If the budget does not allow to re-evaluate all of them, only
+  /// the best ones are re-evaluated and no new samples are injected. The
+  /// others, like survivors skipped because of the deadline, keep their
+  /// stale objectives. New samples that are skipped get back their previous
+  /// parameters.
+  void respond_to_change(generic::random_number_generator auto&& rng) {
+    LYRAHGAMES_PARETO_TRACE_SCOPE("nsga2::respond_to_change");
+    using namespace std;
+    const auto n = problem.parameter_count();
+    const auto m = problem.objective_count();
+    ++changes;
+    if (limits.expired()) return;
+    const auto count = min(select, limits.remaining(evaluations));
+    if (count == 0) return;
+
+    const auto first = s - count;
+    const auto injected = (count == select) ? diversity : 0;
+    // New samples continue the sequence of the configured sampling method.
+    replaced_parameters.resize(n * injected);
+    samples.sample(problem, injected, replaced_parameters.data(), rng);
+    for (size_t i = 0; i < injected; ++i) {
+      const auto index = permutation[first + i];
+      swap_ranges(&parameters[n * index], &parameters[n * (index + 1)],
+                  &replaced_parameters[n * i]);
+      costs[index] = 0;
+    }
+    const auto index = [&](size_t i) { return permutation[first + i]; };
+    evaluations += count;
+    evaluations -= evaluate_individuals(
+        count, index, [&](size_t i) { return &objectives[m * index(i)]; },
+        [&](size_t i) {
+          if (i < injected)
+            copy_n(&replaced_parameters[n * i], n, &parameters[n * index(i)]);
+        });
+
+    ranks.resize(s);
+    // The history of the surrogate model and the biases are outdated.
+    model.clear();
+    learn(first, s);
+    reset_biases();
+    calibrate_fidelities(first, s);
+    progress.reset();
+  }
+
+  /// Returns the number of detected changes of the objectives.
+  auto change_count() const noexcept { return changes; }
+
   /// This function can be applied multiple times to further improve the
-  /// estimation of the Pareto frontier.
+  /// estimation of the Pareto frontier. In dynamic mode, every iteration
+  /// starts by checking the sentinels for changes of the objectives. No
+  /// iteration is started after the budget has been exhausted.
   void optimize(generic::random_number_generator auto&& rng,
                 size_t iterations) {
-    for (size_t i = 0; i < iterations; ++i) {
-      populate(rng);
-      non_dominated_sort();
-      crowding_distance_sort();
+    optimize(std::forward<decltype(rng)>(rng), iterations, no_observer{});
+  }
+
+  /// Calls the given observer after every generation with the statistics of
+  /// that generation. If the observer returns false, the optimization stops.
+  /// Nothing is measured for the default observer. Observers owning
+  /// performance counters, like those given by 'with_counters', additionally
+  /// get the counter values of every phase.
+  void optimize(generic::random_number_generator auto&& rng,
+                size_t iterations,
+                generic::generation_observer auto&& observer) {
+    for (size_t i = 0; i < iterations && !exhausted(); ++i) {
+      if constexpr (!observed<decltype(observer)>) {
+        if (sentinels > 0 && detect_change(rng)) respond_to_change(rng);
+        populate(rng);
+        non_dominated_sort();
+        crowding_distance_sort();
+        track_progress();
+        ++generations;
+      } else {
+        generation_statistics statistics{};
+        auto& t = statistics.seconds;
+        auto& c = statistics.counters;
+        const auto old_evaluations = evaluations;
+        const auto old_cache_hits = cache_hits;
+
+        if (sentinels > 0)
+          measure(observer, t.change_detection, c.change_detection, [&] {
+            if (detect_change(rng)) respond_to_change(rng);
+          });
+        measure(observer, t.populate, c.populate, [&] { vary(rng); });
+        measure(observer, t.evaluation, c.evaluation,
+                [&] { evaluate_offspring(); });
+        measure(observer, t.non_dominated_sort, c.non_dominated_sort,
+                [&] { non_dominated_sort(); });
+        measure(observer, t.crowding_distance_sort, c.crowding_distance_sort,
+                [&] { crowding_distance_sort(); });
+        track_progress();
+
+        front_sizes.resize(ranks.front_count());
+        for (size_t k = 0; k < front_sizes.size(); ++k)
+          front_sizes[k] = ranks.front(k).size();
+
+        statistics.generation = ++generations;
+        statistics.evaluations = evaluations - old_evaluations;
+        statistics.cache_hits = cache_hits - old_cache_hits;
+        statistics.total_evaluations = evaluations;
+        statistics.total_cache_hits = cache_hits;
+        statistics.front_sizes = front_sizes;
+        if (notify(observer, statistics)) return;
+      }
     }
   }
 
+  /// Checks if the budget of the configuration is exhausted. Offspring that
+  /// could not be evaluated within the budget have been discarded such that
+  /// the population and its Pareto front stay valid. The initial population
+  /// and asynchronously evaluated offspring, which are already submitted
+  /// during the variation, are always evaluated.
+  bool exhausted() const noexcept {
+    return limits.remaining(evaluations) == 0 || limits.expired() ||
+           progress.stagnated();
+  }
+
+  /// Registers the last generation at the stagnation detector. The Pareto
+  /// front changed if one of the inserted points entered it.
+  void track_progress() {
+    using namespace std;
+    if (limits.stagnation == 0) return;
+    const auto m = problem.objective_count();
+    const auto changed = ranges::any_of(
+        insertions, [&](auto i) { return ranks.rank(i) == 0; });
+    progress.update(changed, m, [&] {
+      front_objectives.resize(m * fronts[1]);
+      for (size_t i = 0; i < fronts[1]; ++i)
+        copy_n(&objectives[m * permutation[s - 1 - i]], m,
+               &front_objectives[m * i]);
+      return span<const real>{front_objectives};
+    });
+  }
+
+  /// Returns the number of generations since the start.
+  auto generation_count() const noexcept { return generations; }
+  /// Returns the number of calls to the problem's evaluation since the start.
+  auto evaluation_count() const noexcept { return evaluations; }
+  /// Returns the number of evaluations skipped by reusing objectives.
+  auto cache_hit_count() const noexcept { return cache_hits; }
+  /// Returns the number of evaluations done by updating the objectives of a
+  /// parent. They are included in the evaluation count.
+  auto delta_evaluation_count() const noexcept { return delta_evaluations; }
+  /// Returns the number of evaluations below the highest level of fidelity.
+  /// They are not included in the evaluation count.
+  auto low_fidelity_evaluation_count() const noexcept {
+    return low_fidelity_evaluations;
+  }
+
   /// Uses the iterations count given by construction.
   void optimize(generic::random_number_generator auto&& rng) {
     optimize(std::forward<decltype(rng)>(rng), iter);
   }
 
+  /// Appends the parameters and objectives of at most 'count' randomly chosen
+  /// points of the current Pareto front to the given arrays such that they
+  /// can be sent to another population.
+  void emigrate(size_t count,
+                generic::random_number_generator auto&& rng,
+                std::vector<real>& x,
+                std::vector<real>& y) const {
+    using namespace std;
+    const auto n = problem.parameter_count();
+    const auto m = problem.objective_count();
+
+    // Partially shuffle the Pareto front to choose the emigrants.
+    vector<size_t> indices(permutation.end() - fronts[1], permutation.end());
+    count = min(count, indices.size());
+    for (size_t i = 0; i < count; ++i) {
+      swap(indices[i], indices[uniform_int_distribution<size_t>{
+                           i, indices.size() - 1}(rng)]);
+      const auto index = indices[i];
+      x.insert(x.end(), &parameters[n * index], &parameters[n * (index + 1)]);
+      y.insert(y.end(), &objectives[m * index], &objectives[m * (index + 1)]);
+    }
+  }
+
+  /// Replaces the worst surviving points by 'count' immigrants whose
+  /// parameters and objectives are stored contiguously in 'x' and 'y'. At most
+  /// all surviving points are replaced. Afterwards, the population is sorted
+  /// again such that the next generation treats immigrants like all others.
+  void immigrate(size_t count, const real* x, const real* y) {
+    using namespace std;
+    const auto n = problem.parameter_count();
+    const auto m = problem.objective_count();
+
+    // Surviving points start at 's - select' with the worst ones first.
+    count = min(count, select);
+    for (size_t i = 0; i < count; ++i) {
+      const auto index = permutation[s - select + i];
+      ranks.remove(objectives.data(), m, index);
+      copy_n(&x[n * i], n, &parameters[n * index]);
+      copy_n(&y[m * i], m, &objectives[m * index]);
+    }
+    non_dominated_sort();
+    crowding_distance_sort();
+  }
+
   /// Casts the estimated Pareto points stored as an implementation detail into
   /// a usable frontier data structure.
   template <generic::frontier frontier_type>
@@ -403,6 +1332,23 @@ class optimizer {
     return frontier;
   }
 
+  /// Casts the whole population into the given frontier structure ordered
+  /// from the best to the worst domination layer. Such a snapshot can be
+  /// stored and used to warm-start later optimizations.
+  template <generic::frontier frontier_type>
+  auto population_cast() const {
+    using namespace std;
+    const auto n = problem.parameter_count();
+    const auto m = problem.objective_count();
+    frontier_type frontier{s, n, m};
+    for (size_t i = 0; i < s; ++i) {
+      const auto index = permutation[s - 1 - i];
+      copy_n(&parameters[n * index], n, frontier.parameters_iterator(i));
+      copy_n(&objectives[m * index], m, frontier.objectives_iterator(i));
+    }
+    return frontier;
+  }
+
  private:
   problem_type problem{};
 
@@ -411,7 +1357,62 @@ class optimizer {
   std::vector<size_t> permutation{};
   std::vector<real> crowding_distances{};
   std::vector<size_t> fronts{};
-  std::unordered_set<size_t> pareto_indices{};
+  /// Persistent domination layers and scratch memory for unranked points
+  ranked_population<real> ranks{};
+  std::vector<size_t> insertions{};
+  /// Scratch memory for batch evaluations and newly sampled parameters
+  std::vector<real> batch_parameters{};
+  std::vector<real> batch_objectives{};
+  /// Measured or predicted evaluation time of every individual in seconds and
+  /// scratch memory for the evaluation scheduler
+  std::vector<double> costs{};
+  std::vector<double> predictions{};
+  std::vector<double> durations{};
+  /// Parent and range of changed parameter indices of every offspring of the
+  /// large-scale mode. Other offspring are not tracked.
+  struct lineage {
+    static constexpr size_t none = -1;
+    bool tracked() const noexcept { return parent != none; }
+    size_t parent = none;
+    size_t first = 0;
+    size_t last = 0;
+  };
+  std::vector<lineage> lineages{};
+  std::vector<size_t> changed{};
+  /// Parents of every candidate of the prescreening, the surrogate model
+  /// predicting their objectives, and scratch memory for their ranking
+  std::vector<std::pair<size_t, size_t>> origins{};
+  surrogate<real> model{};
+  std::vector<ptrdiff_t> scores{};
+  std::vector<size_t> ranking{};
+  /// Objectives of all levels of fidelity below the highest one, the sums
+  /// and number of their differences to the highest level, and scratch
+  /// memory for the promotion of offspring
+  std::vector<real> fidelity_objectives{};
+  std::vector<real> bias_sums{};
+  size_t bias_samples = 0;
+  std::vector<bool> promotions{};
+  std::vector<size_t> previous_permutation{};
+  /// Parameter indices stored group after group and the offsets of the groups
+  std::vector<size_t> grouping{};
+  std::vector<size_t> group_offsets{};
+  /// Scratch memory to choose distinct parameters for sparse mutations
+  std::vector<bool> marks{};
+  /// Budget of the optimization, its stagnation detector, and scratch memory
+  /// for the objectives of the Pareto front
+  pareto::budget limits{};
+  stagnation_detector<real> progress{};
+  std::vector<real> front_objectives{};
+  /// Scratch memory for the indices and objectives of re-evaluated sentinels
+  std::vector<size_t> sentinel_indices{};
+  std::vector<real> sentinel_objectives{};
+  /// Scratch memory for the parameters of survivors replaced after a change
+  std::vector<real> replaced_parameters{};
+  /// Generator for the parameters of the initial population and of the new
+  /// samples after a change
+  sampler<real> samples{};
+  /// Statistics for observers
+  std::vector<size_t> front_sizes{};
 
   /// Population Size
   size_t s;
@@ -421,6 +1422,28 @@ class optimizer {
   size_t iter;
   /// Crossover/Mutation Ratio per Iteration
   float crossover_probability;
+  size_t threads;
+  evaluation_scheduler scheduler{};
+  /// Number of survivors re-evaluated to detect changes of the objectives
+  size_t sentinels;
+  float change_tolerance;
+  /// Number of survivors replaced by random samples after a change
+  size_t diversity;
+  /// Configured number of groups, the next group, and the number of mutated
+  /// parameters of the large-scale mode
+  size_t groups = 0;
+  size_t group = 0;
+  size_t mutated = 0;
+  /// Number of candidates generated per offspring by the prescreening
+  size_t candidates = 1;
+  size_t changes = 0;
+  size_t generations = 0;
+  size_t evaluations = 0;
+  size_t cache_hits = 0;
+  size_t delta_evaluations = 0;
+  size_t low_fidelity_evaluations = 0;
+  /// Number of cached offspring of the current generation
+  size_t hits = 0;
 };
 
 template <problem problem_type>
@@ -448,6 +1471,40 @@ auto optimization(
       optimization(problem, std::forward<decltype(rng)>(rng), config));
 }
 
+/// Independent optimization of a batch. The seed initializes the random
+/// number generator of the job such that results do not depend on the order
+/// of execution.
+template <problem problem_type>
+struct job {
+  problem_type problem{};
+  typename optimizer<problem_type>::configuration config{};
+  uint64_t seed = 0;
+};
+
+/// Runs all given jobs concurrently on a shared pool of threads and calls
+/// 'sink(index, frontier)' in completion order. Every thread reuses one
+/// optimizer instance for all of its jobs. Jobs with more evaluations are
+/// started first.
+template <generic::frontier frontier_type, problem problem_type>
+void batch_optimization(const std::vector<job<problem_type>>& jobs,
+                        auto&& sink,
+                        size_t threads = default_thread_count()) {
+  using namespace std;
+  vector<double> costs(jobs.size());
+  for (size_t i = 0; i < jobs.size(); ++i)
+    costs[i] = double(jobs[i].config.iterations) * jobs[i].config.population;
+  run_batch<optimizer<problem_type>>(
+      jobs.size(),
+      [&](auto& instance, size_t index) {
+        const auto& job = jobs[index];
+        mt19937_64 rng{job.seed};
+        instance.reset(job.problem, rng, job.config);
+        instance.optimize(rng);
+        return instance.template frontier_cast<frontier_type>();
+      },
+      sink, costs, threads);
+}
+
 }  // namespace nsga2
 
 }  // namespace lyrahgames::pareto
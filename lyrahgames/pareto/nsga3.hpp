@@ -0,0 +1,527 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <span>
+#include <unordered_set>
+#include <vector>
+//
+#include <lyrahgames/pareto/frontier_cast.hpp>
+#include <lyrahgames/pareto/meta.hpp>
+#include <lyrahgames/pareto/non_dominated_sort.hpp>
+#include <lyrahgames/pareto/parallel.hpp>
+#include <lyrahgames/pareto/reference_points.hpp>
+#include <lyrahgames/pareto/tracing.hpp>
+#include <lyrahgames/pareto/variation.hpp>
+
+namespace lyrahgames::pareto {
+
+namespace nsga3 {
+
+/// Specialized Pareto Problems for the NSGA3 Algorithm
+template <typename T>
+concept problem = generic::evaluatable_problem<T,
+                                               std::span<typename T::real>,
+                                               std::span<typename T::real>>;
+
+/// NSGA3 Optimization Algorithm for Many-Objective Problems
+/// The population is sorted into domination layers like in the NSGA2
+/// algorithm. The last layer that only partially survives is not sorted by
+/// crowding distances but by niching with respect to structured reference
+/// points on the normalized hyperplane. The reference points should be chosen
+/// such that their number roughly equals the population size.
+template <problem T>
+class optimizer {
+ public:
+  using problem_type = T;
+  using real = typename problem_type::real;
+
+  /// Structure to provide easy intialization of the parameters of the
+  /// algorithm. By using designated initializers, named function arguments can
+  /// be simulated. The reference points are given by the number of outer and
+  /// inner divisions of the two-layered simplex lattice.
+  struct configuration {
+    size_t iterations = 1000;
+    size_t population = 1000;
+    float kill_ratio = 0.5;
+    float crossover_ratio = 0.3;
+    size_t divisions = 12;
+    size_t inner_divisions = 0;
+    size_t threads = default_thread_count();
+  };
+
+  optimizer() = default;
+  explicit optimizer(problem_type p,
+                     generic::random_number_generator auto&& rng,
+                     configuration config = {})
+      : problem(p),
+        s(config.population),
+        select(std::floor((1 - config.kill_ratio) * config.population)),
+        iter(config.iterations),
+        crossover_probability(config.crossover_ratio),
+        threads(config.threads) {
+    init(config.divisions, config.inner_divisions);
+    init_population(std::forward<decltype(rng)>(rng));
+  }
+
+  void init(size_t divisions, size_t inner_divisions) {
+    using namespace std;
+    const auto n = problem.parameter_count();
+    const auto m = problem.objective_count();
+    parameters.resize(n * s);
+    objectives.resize(m * s);
+    permutation.resize(s);
+    pareto_indices.reserve(s);
+
+    // Store normalized reference directions in a structure-of-arrays layout
+    // to vectorize the association over all reference points.
+    const auto w = reference_points<real>(m, divisions, inner_divisions);
+    r = w.size() / m;
+    directions.resize(m * r);
+    for (size_t k = 0; k < r; ++k) {
+      real norm = 0;
+      for (size_t j = 0; j < m; ++j)
+        norm += w[m * k + j] * w[m * k + j];
+      norm = sqrt(norm);
+      for (size_t j = 0; j < m; ++j)
+        directions[r * j + k] = w[m * k + j] / norm;
+    }
+    niche_counts.resize(r);
+    survives.resize(s);
+    normalized.resize(m * s);
+    associations.resize(s);
+    distances.resize(s);
+  }
+
+  /// Returns the number of used reference points.
+  auto reference_point_count() const noexcept { return r; }
+
+  /// Clamp the parameters referenced by the given index to the box constraints
+  /// defined by the current problem.
+  void clamp(size_t index) {
+    using std::clamp;
+    const auto n = problem.parameter_count();
+    for (size_t i = 0; i < n; ++i)
+      parameters[n * index + i] = clamp(parameters[n * index + i],
+                                        problem.box_min(i), problem.box_max(i));
+  }
+
+  /// Evaluate all objectives at the given index by using the parameters
+  /// referenced by the given index.
+  void evaluate(size_t index) {
+    using std::span;
+    const auto n = problem.parameter_count();
+    const auto m = problem.objective_count();
+    problem.evaluate(
+        span{&parameters[n * index], &parameters[n * (index + 1)]},
+        span{&objectives[m * index], &objectives[m * (index + 1)]});
+  }
+
+  /// Generates a random population to start with the optimization algorithm.
+  void init_population(generic::random_number_generator auto&& rng) {
+    using namespace std;
+    const auto n = problem.parameter_count();
+
+    uniform_real_distribution<real> distribution{0, 1};
+    const auto random = [&] { return distribution(rng); };
+
+    for (size_t i = 0; i < s; ++i) {
+      for (size_t j = 0; j < n; ++j)
+        parameters[n * i + j] =
+            lerp(problem.box_min(j), problem.box_max(j), random());
+      evaluate(i);
+    }
+
+    non_dominated_sort();
+    reference_point_sort(rng);
+  }
+
+  /// Sort the current population into their layers of domination.
+  void non_dominated_sort() {
+    LYRAHGAMES_PARETO_TRACE_SCOPE("nsga3::non_dominated_sort");
+    pareto::non_dominated_sort(objectives.data(), problem.objective_count(), s,
+                               select, permutation, fronts, pareto_indices);
+  }
+
+  /// Normalizes the objectives of all sorted points by using the ideal point
+  /// and the intercepts of the hyperplane spanned by the extreme points.
+  void normalize() {
+    LYRAHGAMES_PARETO_TRACE_SCOPE("nsga3::normalize");
+    using namespace std;
+    const auto m = problem.objective_count();
+    const auto first = s - fronts.back();
+    constexpr real epsilon = 1e-6;
+
+    // Compute the ideal point and translate all objectives.
+    vector<real> ideal(m, numeric_limits<real>::infinity());
+    for (size_t i = first; i < s; ++i)
+      for (size_t j = 0; j < m; ++j)
+        ideal[j] = min(ideal[j], objectives[m * permutation[i] + j]);
+    vector<real> worst(m, 0);
+    for (size_t i = first; i < s; ++i) {
+      const auto index = permutation[i];
+      for (size_t j = 0; j < m; ++j) {
+        normalized[m * index + j] = objectives[m * index + j] - ideal[j];
+        worst[j] = max(worst[j], normalized[m * index + j]);
+      }
+    }
+
+    // Find the extreme point of every axis by minimizing the achievement
+    // scalarizing function.
+    vector<real> system(m * (m + 1));
+    for (size_t a = 0; a < m; ++a) {
+      auto best = numeric_limits<real>::infinity();
+      size_t extreme = permutation[first];
+      for (size_t i = first; i < s; ++i) {
+        const auto index = permutation[i];
+        real asf = 0;
+        for (size_t j = 0; j < m; ++j)
+          asf = max(asf, normalized[m * index + j] / ((j == a) ? 1 : epsilon));
+        if (asf < best) {
+          best = asf;
+          extreme = index;
+        }
+      }
+      for (size_t j = 0; j < m; ++j)
+        system[(m + 1) * a + j] = normalized[m * extreme + j];
+      system[(m + 1) * a + m] = 1;
+    }
+
+    // Solve for the hyperplane through the extreme points by Gaussian
+    // elimination with partial pivoting. If the system is degenerate, the
+    // worst objective values are used as intercepts.
+    intercepts = worst;
+    bool degenerate = false;
+    for (size_t c = 0; c < m && !degenerate; ++c) {
+      size_t pivot = c;
+      for (size_t i = c + 1; i < m; ++i)
+        if (abs(system[(m + 1) * i + c]) > abs(system[(m + 1) * pivot + c]))
+          pivot = i;
+      if (abs(system[(m + 1) * pivot + c]) < epsilon) {
+        degenerate = true;
+        break;
+      }
+      for (size_t j = 0; j <= m; ++j)
+        swap(system[(m + 1) * c + j], system[(m + 1) * pivot + j]);
+      for (size_t i = 0; i < m; ++i) {
+        if (i == c) continue;
+        const auto factor = system[(m + 1) * i + c] / system[(m + 1) * c + c];
+        for (size_t j = c; j <= m; ++j)
+          system[(m + 1) * i + j] -= factor * system[(m + 1) * c + j];
+      }
+    }
+    if (!degenerate) {
+      for (size_t j = 0; j < m; ++j) {
+        const auto a = system[(m + 1) * j + m] / system[(m + 1) * j + j];
+        const auto intercept = 1 / a;
+        if (!(intercept > epsilon) || !isfinite(intercept)) {
+          degenerate = true;
+          break;
+        }
+        intercepts[j] = intercept;
+      }
+      if (degenerate) intercepts = worst;
+    }
+    for (auto& x : intercepts)
+      if (x < epsilon) x = 1;
+
+    for (size_t i = first; i < s; ++i) {
+      const auto index = permutation[i];
+      for (size_t j = 0; j < m; ++j)
+        normalized[m * index + j] /= intercepts[j];
+    }
+  }
+
+  /// Associates every sorted point with the reference direction of smallest
+  /// perpendicular distance. The cost is linear in the number of points times
+  /// the number of reference points and the points are distributed over
+  /// threads. The inner loops run over contiguous reference directions.
+  void associate() {
+    LYRAHGAMES_PARETO_TRACE_SCOPE("nsga3::associate");
+    using namespace std;
+    const auto m = problem.objective_count();
+    const auto first = s - fronts.back();
+    constexpr size_t grain = 64;
+
+    if (dots.size() < threads) dots.resize(threads);
+    parallel_for(
+        s - first,
+        [&](size_t thread, size_t begin, size_t end) {
+          auto& dot = dots[thread];
+          dot.resize(r);
+          for (size_t i = first + begin; i < first + end; ++i) {
+            const auto index = permutation[i];
+            const auto f = &normalized[m * index];
+            fill(dot.begin(), dot.end(), real{0});
+            real norm = 0;
+            for (size_t j = 0; j < m; ++j) {
+              norm += f[j] * f[j];
+              const auto direction = &directions[r * j];
+              for (size_t k = 0; k < r; ++k)
+                dot[k] += f[j] * direction[k];
+            }
+            size_t best = 0;
+            for (size_t k = 1; k < r; ++k)
+              if (dot[k] > dot[best]) best = k;
+            associations[index] = best;
+            distances[index] = sqrt(max(real{0}, norm - dot[best] * dot[best]));
+          }
+        },
+        threads, grain);
+  }
+
+  /// Sort the last domination layer that only partially survives such that
+  /// the surviving points fill up the least crowded reference niches. The
+  /// surviving points are placed at the end of the layer.
+  void reference_point_sort(generic::random_number_generator auto&& rng) {
+    LYRAHGAMES_PARETO_TRACE_SCOPE("nsga3::reference_point_sort");
+    using namespace std;
+
+    // If we have exactly the amount of needed points, no niching is required.
+    if (fronts.back() == select) return;
+
+    normalize();
+    associate();
+
+    // Compute range for the last front to only sort the last front.
+    const auto first = s - fronts[fronts.size() - 1];
+    const auto last = s - fronts[fronts.size() - 2];
+    auto remaining = select - fronts[fronts.size() - 2];
+
+    // Count the niche members of all surely surviving points.
+    fill(niche_counts.begin(), niche_counts.end(), 0);
+    for (size_t i = last; i < s; ++i)
+      ++niche_counts[associations[permutation[i]]];
+
+    // Group the candidates of the last front by their reference point.
+    candidates.clear();
+    for (size_t i = first; i < last; ++i) {
+      const auto index = permutation[i];
+      candidates.push_back({associations[index], index});
+    }
+    sort(candidates.begin(), candidates.end());
+    niches.clear();
+    for (size_t i = 0; i < candidates.size(); ++i)
+      if (i == 0 || candidates[i].first != candidates[i - 1].first)
+        niches.push_back({candidates[i].first, i, i});
+    for (auto& niche : niches)
+      while (niche.last < candidates.size() &&
+             candidates[niche.last].first == niche.reference)
+        ++niche.last;
+
+    // Repeatedly choose a point of the least crowded niche.
+    chosen.clear();
+    vector<size_t> ties{};
+    while (remaining > 0) {
+      ties.clear();
+      auto minimum = numeric_limits<size_t>::max();
+      for (size_t k = 0; k < niches.size(); ++k) {
+        const auto count = niche_counts[niches[k].reference];
+        if (count < minimum) {
+          minimum = count;
+          ties.clear();
+        }
+        if (count == minimum) ties.push_back(k);
+      }
+      const auto k =
+          ties[uniform_int_distribution<size_t>{0, ties.size() - 1}(rng)];
+      auto& niche = niches[k];
+
+      // Empty niches take the point nearest to their reference direction.
+      auto pick = niche.first;
+      if (minimum == 0) {
+        for (auto i = niche.first + 1; i < niche.last; ++i)
+          if (distances[candidates[i].second] <
+              distances[candidates[pick].second])
+            pick = i;
+      } else {
+        pick = uniform_int_distribution<size_t>{niche.first,
+                                                niche.last - 1}(rng);
+      }
+      chosen.push_back(candidates[pick].second);
+      swap(candidates[pick], candidates[niche.last - 1]);
+      --niche.last;
+      ++niche_counts[niche.reference];
+      --remaining;
+
+      if (niche.first == niche.last) {
+        niches[k] = niches.back();
+        niches.pop_back();
+      }
+    }
+
+    // Put the rejected points at the beginning and the chosen points at the
+    // end of the last front.
+    for (auto index : chosen)
+      survives[index] = true;
+    auto it = &permutation[first];
+    for (const auto& [reference, index] : candidates)
+      if (!survives[index]) *it++ = index;
+    for (auto index : chosen) {
+      *it++ = index;
+      survives[index] = false;
+    }
+  }
+
+  /// Generate new population by replacing the worst points with offspring of
+  /// the surviving points.
+  void populate(generic::random_number_generator auto&& rng) {
+    LYRAHGAMES_PARETO_TRACE_SCOPE("nsga3::populate");
+    using namespace std;
+
+    // Introduce short-hand notations.
+    const auto n = problem.parameter_count();
+
+    // Add oracle for random index.
+    // All good points are stored at the end of the permutation.
+    uniform_int_distribution<size_t> distribution{s - select, s - 1};
+    const auto random = [&] { return distribution(rng); };
+
+    // Compute count of crossovers.
+    const size_t count = s - select;
+    const size_t crossover_count =
+        2 * size_t(crossover_probability * (count / 2));
+
+    size_t i = 0;
+
+    // Crossover
+    for (; i < crossover_count; i += 2) {
+      const auto parent1 = permutation[random()];
+      const auto parent2 = permutation[random()];
+      const auto offspring1 = permutation[i + 0];
+      const auto offspring2 = permutation[i + 1];
+
+      simulated_binary_crossover(
+          n, &parameters[n * parent1], &parameters[n * parent2],
+          &parameters[n * offspring1], &parameters[n * offspring2], rng);
+      // Make sure newly generated parameters fulfill the box constraints.
+      clamp(offspring1);
+      clamp(offspring2);
+      evaluate(offspring1);
+      evaluate(offspring2);
+    }
+
+    // Mutation
+    for (; i < count; ++i) {
+      const auto parent = permutation[random()];
+      const auto offspring = permutation[i];
+
+      alternate_random_mutation(problem, &parameters[n * parent],
+                                &parameters[n * offspring], rng);
+      // Make sure newly generated parameters fulfill the box constraints.
+      clamp(offspring);
+      evaluate(offspring);
+    }
+  }
+
+  /// This function can be applied multiple times to further improve the
+  /// estimation of the Pareto frontier.
+  void optimize(generic::random_number_generator auto&& rng,
+                size_t iterations) {
+    for (size_t i = 0; i < iterations; ++i) {
+      populate(rng);
+      non_dominated_sort();
+      reference_point_sort(rng);
+    }
+  }
+
+  /// Uses the iterations count given by construction.
+  void optimize(generic::random_number_generator auto&& rng) {
+    optimize(std::forward<decltype(rng)>(rng), iter);
+  }
+
+  /// Casts the estimated Pareto points stored as an implementation detail into
+  /// a usable frontier data structure.
+  template <generic::frontier frontier_type>
+  auto frontier_cast() const {
+    using namespace std;
+    const auto n = problem.parameter_count();
+    const auto m = problem.objective_count();
+    frontier_type frontier{fronts[1], n, m};
+    for (size_t i = 0; i < fronts[1]; ++i) {
+      const auto index = permutation[s - 1 - i];
+      {
+        auto it = frontier.parameters_iterator(i);
+        for (size_t j = 0; j < n; ++j, ++it)
+          *it = parameters[n * index + j];
+      }
+      {
+        auto it = frontier.objectives_iterator(i);
+        for (size_t j = 0; j < m; ++j, ++it)
+          *it = objectives[m * index + j];
+      }
+    }
+    return frontier;
+  }
+
+ private:
+  struct niche {
+    size_t reference;
+    size_t first;
+    size_t last;
+  };
+
+  problem_type problem{};
+
+  std::vector<real> parameters{};
+  std::vector<real> objectives{};
+  std::vector<size_t> permutation{};
+  std::vector<size_t> fronts{};
+  std::unordered_set<size_t> pareto_indices{};
+
+  /// Reference directions of unit length stored component-wise.
+  std::vector<real> directions{};
+  /// Number of reference points
+  size_t r;
+  std::vector<real> intercepts{};
+  std::vector<real> normalized{};
+  std::vector<size_t> associations{};
+  std::vector<real> distances{};
+  std::vector<size_t> niche_counts{};
+  std::vector<std::pair<size_t, size_t>> candidates{};
+  std::vector<niche> niches{};
+  std::vector<size_t> chosen{};
+  std::vector<bool> survives{};
+  /// Per-thread scratch memory for the association of points.
+  std::vector<std::vector<real>> dots{};
+
+  /// Population Size
+  size_t s;
+  /// Number of samples kept alive after one iteration.
+  size_t select;
+  /// Number of iterations given by initialization.
+  size_t iter;
+  /// Crossover/Mutation Ratio per Iteration
+  float crossover_probability;
+  /// Number of threads used for the association of points.
+  size_t threads;
+};
+
+/// Short-hand function to set the parameters and optimize in one step. This
+/// function returns an instance to the NSGA3 optimizer.
+auto optimization(
+    problem auto problem,
+    generic::random_number_generator auto&& rng,
+    typename optimizer<decltype(problem)>::configuration config = {}) {
+  optimizer result(problem, rng, config);
+  result.optimize(std::forward<decltype(rng)>(rng));
+  return result;
+}
+
+/// Short-hand function overload to additionally make a frontier cast after
+/// optimization and discard the optimizer instance in one step.
+template <generic::frontier frontier_type>
+auto optimization(
+    problem auto problem,
+    generic::random_number_generator auto&& rng,
+    typename optimizer<decltype(problem)>::configuration config = {}) {
+  return frontier_cast<frontier_type>(
+      optimization(problem, std::forward<decltype(rng)>(rng), config));
+}
+
+}  // namespace nsga3
+
+}  // namespace lyrahgames::pareto
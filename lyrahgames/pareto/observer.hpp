@@ -0,0 +1,126 @@
+#pragma once
+#include <chrono>
+#include <concepts>
+#include <span>
+#include <type_traits>
+#include <utility>
+//
+#include <lyrahgames/pareto/meta.hpp>
+#include <lyrahgames/pareto/perf_counters.hpp>
+
+namespace lyrahgames::pareto {
+
+/// Statistics of one generation that optimizers report to observers. Times
+/// are given in seconds. Evaluations skipped because the objectives could be
+/// reused, like for offspring identical to their parent, count as cache hits.
+struct generation_statistics {
+  /// Wall-clock time spent in the phases of the generation
+  struct timings {
+    double change_detection = 0;
+    double populate = 0;
+    double evaluation = 0;
+    double non_dominated_sort = 0;
+    double crowding_distance_sort = 0;
+  };
+
+  /// Performance counters of the phases of the generation
+  struct counts {
+    hardware_counters change_detection{};
+    hardware_counters populate{};
+    hardware_counters evaluation{};
+    hardware_counters non_dominated_sort{};
+    hardware_counters crowding_distance_sort{};
+  };
+
+  /// Number of generations finished since the start including this one
+  size_t generation = 0;
+  timings seconds{};
+  /// Only gathered for counting observers
+  counts counters{};
+  size_t evaluations = 0;
+  size_t cache_hits = 0;
+  size_t total_evaluations = 0;
+  size_t total_cache_hits = 0;
+  /// Sizes of all domination layers beginning with the Pareto front
+  std::span<const size_t> front_sizes{};
+};
+
+namespace generic {
+
+/// Observers are called after every generation. If their result is
+/// convertible to 'bool', returning 'false' requests the optimizer to stop.
+template <typename T>
+concept generation_observer = std::invocable<T&, const generation_statistics&>;
+
+/// Observers owning performance counters additionally get the counter values
+/// of every phase.
+template <typename T>
+concept counting_observer = generation_observer<T> && requires(T& observer) {
+  { observer.counters } -> std::same_as<perf_counters&>;
+};
+
+}  // namespace generic
+
+/// Default observer of optimizers. Optimizers do not measure and gather any
+/// statistics when this observer is used.
+struct no_observer {
+  constexpr void operator()(const generation_statistics&) const noexcept {}
+};
+
+/// Observer that forwards to the given function and owns performance counters
+/// such that the statistics contain the counter values of every phase.
+template <typename function>
+struct observer_with_counters {
+  perf_counters counters{};
+  function f;
+  decltype(auto) operator()(const generation_statistics& statistics) {
+    return f(statistics);
+  }
+};
+
+/// Wraps the given observer function such that it gets performance counters.
+template <typename function>
+auto with_counters(function&& f) {
+  return observer_with_counters<std::decay_t<function>>{
+      {}, std::forward<function>(f)};
+}
+
+/// Checks at compile time whether the given observer needs statistics.
+template <typename T>
+constexpr bool observed = !std::same_as<std::remove_cvref_t<T>, no_observer>;
+
+/// Calls the observer and returns true if it requested to stop.
+constexpr bool notify(generic::generation_observer auto&& observer,
+                      const generation_statistics& statistics) {
+  using result = decltype(observer(statistics));
+  if constexpr (std::convertible_to<result, bool>)
+    return !bool(observer(statistics));
+  else {
+    observer(statistics);
+    return false;
+  }
+}
+
+/// Calls 'f()' and adds its wall-clock time in seconds to the given value.
+void measure(double& seconds, auto&& f) {
+  using clock = std::chrono::steady_clock;
+  const auto start = clock::now();
+  f();
+  seconds += std::chrono::duration<double>(clock::now() - start).count();
+}
+
+/// Calls 'f()' and adds its wall-clock time and, for counting observers, its
+/// performance counters to the given values.
+void measure(auto& observer,
+             double& seconds,
+             hardware_counters& counts,
+             auto&& f) {
+  if constexpr (generic::counting_observer<decltype(observer)>) {
+    const auto start = observer.counters.read();
+    measure(seconds, f);
+    counts += observer.counters.read() - start;
+  } else
+    measure(seconds, f);
+}
+
+}  // namespace lyrahgames::pareto
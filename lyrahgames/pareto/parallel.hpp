@@ -0,0 +1,67 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace lyrahgames::pareto {
+
+/// Returns the number of threads that should be used by default for parallel
+/// computations. The value is never smaller than one.
+inline size_t default_thread_count() noexcept {
+  return std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+/// Dynamically distributes the index range [0, count) in chunks of size 'grain'
+/// over the given number of threads. For every chunk, 'f(thread, first, last)'
+/// is called, where 'thread' lies in [0, threads) and can be used to access
+/// thread-local scratch memory. If only one thread is needed, everything is
+/// executed on the calling thread. The first exception thrown by 'f' is
+/// rethrown after all threads have been joined.
+template <typename function>
+void parallel_for(size_t count,
+                  function&& f,
+                  size_t threads = default_thread_count(),
+                  size_t grain = 1) {
+  using namespace std;
+
+  grain = max<size_t>(1, grain);
+  threads = clamp<size_t>(threads, 1, (count + grain - 1) / grain);
+  if (threads <= 1) {
+    if (count > 0) f(size_t{0}, size_t{0}, count);
+    return;
+  }
+
+  atomic<size_t> next{0};
+  exception_ptr error{};
+  mutex error_mutex{};
+
+  const auto work = [&](size_t thread) {
+    try {
+      for (auto first = next.fetch_add(grain, memory_order_relaxed);
+           first < count;
+           first = next.fetch_add(grain, memory_order_relaxed))
+        f(thread, first, min(first + grain, count));
+    } catch (...) {
+      scoped_lock lock{error_mutex};
+      if (!error) error = current_exception();
+      // Make other threads stop as soon as possible.
+      next.store(count, memory_order_relaxed);
+    }
+  };
+
+  vector<thread> workers{};
+  workers.reserve(threads - 1);
+  for (size_t t = 1; t < threads; ++t)
+    workers.emplace_back(work, t);
+  work(0);
+  for (auto& worker : workers)
+    worker.join();
+
+  if (error) rethrow_exception(error);
+}
+
+}  // namespace lyrahgames::pareto
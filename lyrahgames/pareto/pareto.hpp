@@ -3,13 +3,32 @@
 #include <lyrahgames/pareto/version.hpp>
 
 // Optimizer
+#include <lyrahgames/pareto/async_nsga2.hpp>
+#include <lyrahgames/pareto/moead.hpp>
+#include <lyrahgames/pareto/island.hpp>
 #include <lyrahgames/pareto/naive.hpp>
 #include <lyrahgames/pareto/nsga2.hpp>
+#include <lyrahgames/pareto/nsga3.hpp>
+#include <lyrahgames/pareto/sms_emoa.hpp>
 
 // Frontiers
 #include <lyrahgames/pareto/frontier.hpp>
 #include <lyrahgames/pareto/frontier_cast.hpp>
+#include <lyrahgames/pareto/frontier_io.hpp>
+
+// Quality Indicators
+#include <lyrahgames/pareto/hypervolume.hpp>
+#include <lyrahgames/pareto/metrics.hpp>
 
 // Tools
+#include <lyrahgames/pareto/batch.hpp>
+#include <lyrahgames/pareto/benchmark.hpp>
+#include <lyrahgames/pareto/budget.hpp>
+#include <lyrahgames/pareto/evaluation_scheduler.hpp>
 #include <lyrahgames/pareto/line_cut.hpp>
+#include <lyrahgames/pareto/observer.hpp>
 #include <lyrahgames/pareto/parameter_line_cut.hpp>
+#include <lyrahgames/pareto/perf_counters.hpp>
+#include <lyrahgames/pareto/sampling.hpp>
+#include <lyrahgames/pareto/surrogate.hpp>
+#include <lyrahgames/pareto/tracing.hpp>
@@ -0,0 +1,138 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <utility>
+//
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace lyrahgames::pareto {
+
+/// Values of performance counters. Counters that are not supported by the
+/// system stay zero. The task clock gives the CPU time in nanoseconds summed
+/// over all counted threads.
+struct hardware_counters {
+  uint64_t cycles = 0;
+  uint64_t instructions = 0;
+  uint64_t cache_misses = 0;
+  uint64_t branch_misses = 0;
+  uint64_t task_clock = 0;
+
+  double instructions_per_cycle() const noexcept {
+    return cycles ? double(instructions) / double(cycles) : 0;
+  }
+
+  hardware_counters& operator+=(const hardware_counters& x) noexcept {
+    cycles += x.cycles;
+    instructions += x.instructions;
+    cache_misses += x.cache_misses;
+    branch_misses += x.branch_misses;
+    task_clock += x.task_clock;
+    return *this;
+  }
+
+  friend hardware_counters operator-(const hardware_counters& x,
+                                     const hardware_counters& y) noexcept {
+    return {x.cycles - y.cycles, x.instructions - y.instructions,
+            x.cache_misses - y.cache_misses, x.branch_misses - y.branch_misses,
+            x.task_clock - y.task_clock};
+  }
+};
+
+/// Collector of Performance Counters based on Linux 'perf_event_open'
+/// Counters start on construction and count user-space events of the
+/// constructing thread and of all threads it creates afterwards. Events of
+/// threads are added when they exit, like after the evaluation scheduler has
+/// joined its workers. Phases are measured by the difference of two reads. If
+/// the hardware or the permissions, given by
+/// '/proc/sys/kernel/perf_event_paranoid', do not allow a counter, it stays
+/// zero. On other systems, no counter is available.
+class perf_counters {
+ public:
+  perf_counters() {
+#if defined(__linux__)
+    constexpr std::array<std::pair<uint32_t, uint64_t>, count> events{{
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK},
+    }};
+    for (size_t i = 0; i < count; ++i) {
+      perf_event_attr attr{};
+      attr.size = sizeof(attr);
+      attr.type = events[i].first;
+      attr.config = events[i].second;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.inherit = 1;
+      // Counters may be multiplexed if there are not enough of them.
+      attr.read_format =
+          PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      fds[i] = int(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+#endif
+  }
+
+  ~perf_counters() { close(); }
+
+  perf_counters(const perf_counters&) = delete;
+  perf_counters& operator=(const perf_counters&) = delete;
+
+  perf_counters(perf_counters&& x) noexcept
+      : fds{std::exchange(x.fds, invalid())} {}
+  perf_counters& operator=(perf_counters&& x) noexcept {
+    std::swap(fds, x.fds);
+    return *this;
+  }
+
+  /// Checks whether the hardware counters, not only the task clock, work.
+  bool available() const noexcept { return fds[0] >= 0; }
+
+  /// Returns the values counted since construction.
+  hardware_counters read() const noexcept {
+    hardware_counters result{};
+    result.cycles = value(0);
+    result.instructions = value(1);
+    result.cache_misses = value(2);
+    result.branch_misses = value(3);
+    result.task_clock = value(4);
+    return result;
+  }
+
+ private:
+  static constexpr size_t count = 5;
+
+  static constexpr std::array<int, count> invalid() noexcept {
+    return {-1, -1, -1, -1, -1};
+  }
+
+  /// Reads one counter and extrapolates it if it has been multiplexed.
+  uint64_t value(size_t i) const noexcept {
+#if defined(__linux__)
+    if (fds[i] < 0) return 0;
+    uint64_t data[3]{};
+    if (::read(fds[i], data, sizeof(data)) != sizeof(data)) return 0;
+    const auto [counted, enabled, running] = data;
+    if (running == 0) return 0;
+    if (running == enabled) return counted;
+    return uint64_t(double(counted) * double(enabled) / double(running));
+#else
+    return 0;
+#endif
+  }
+
+  void close() noexcept {
+#if defined(__linux__)
+    for (auto& fd : fds)
+      if (fd >= 0) ::close(std::exchange(fd, -1));
+#endif
+  }
+
+  std::array<int, count> fds = invalid();
+};
+
+}  // namespace lyrahgames::pareto
@@ -0,0 +1,313 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+//
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+//
+#include <lyrahgames/pareto/meta.hpp>
+#include <lyrahgames/pareto/parallel.hpp>
+#include <lyrahgames/pareto/tracing.hpp>
+
+namespace lyrahgames::pareto {
+
+namespace detail {
+
+/// Waits on or wakes the given shared 32-bit word. The operation is not
+/// restricted to the current process such that forked processes can be
+/// synchronized through shared memory.
+inline long futex(std::atomic<uint32_t>& word,
+                  int operation,
+                  uint32_t value,
+                  const timespec* timeout = nullptr) noexcept {
+  static_assert(std::atomic<uint32_t>::is_always_lock_free &&
+                sizeof(std::atomic<uint32_t>) == sizeof(uint32_t));
+  return syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), operation,
+                 value, timeout, nullptr, 0);
+}
+
+/// Pool of forked worker processes evaluating a problem. All communication
+/// happens through one anonymous shared memory mapping created before forking.
+/// It contains a control block and slots for the parameters and objectives of
+/// 'capacity' samples. Workers evaluate directly on the slots. Because every
+/// worker uses its own copy of the problem, the problem does not need to be
+/// thread-safe.
+template <generic::problem problem_type>
+class process_pool {
+ public:
+  using real = typename problem_type::real;
+
+  process_pool(const problem_type& p, size_t processes, size_t slots)
+      : problem(p),
+        n(problem.parameter_count()),
+        m(problem.objective_count()),
+        capacity(std::max<size_t>(1, slots)) {
+    using namespace std;
+
+    parameters_offset = round_up(sizeof(control), alignof(real));
+    objectives_offset = parameters_offset + capacity * n * sizeof(real);
+    size = objectives_offset + capacity * m * sizeof(real);
+    memory = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                  MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED)
+      throw system_error(errno, generic_category(),
+                         "process_pool: failed to map shared memory");
+    shared = new (memory) control{};
+    parameters = reinterpret_cast<real*>(static_cast<char*>(memory) +
+                                         parameters_offset);
+    objectives = reinterpret_cast<real*>(static_cast<char*>(memory) +
+                                         objectives_offset);
+
+    const auto parent = getpid();
+    processes = max<size_t>(1, processes);
+    workers.reserve(processes);
+    for (size_t i = 0; i < processes; ++i) {
+      const auto pid = fork();
+      if (pid == 0) {
+        // Do not outlive the parent if it is killed.
+        prctl(PR_SET_PDEATHSIG, SIGKILL);
+        if (getppid() != parent) _exit(0);
+        work();
+        _exit(0);
+      }
+      if (pid < 0) {
+        const auto error = errno;
+        shutdown();
+        throw system_error(error, generic_category(),
+                           "process_pool: failed to fork worker process");
+      }
+      workers.push_back(pid);
+    }
+  }
+
+  process_pool(const process_pool&) = delete;
+  process_pool& operator=(const process_pool&) = delete;
+
+  ~process_pool() { shutdown(); }
+
+  auto process_count() const noexcept { return workers.size(); }
+
+  /// Evaluates 'count' samples whose parameters and objectives are stored
+  /// contiguously. Larger batches are split into chunks fitting the slots.
+  /// Calls from different threads are serialized.
+  void evaluate(const real* x, real* y, size_t count) {
+    LYRAHGAMES_PARETO_TRACE_SCOPE("process_pool::evaluate");
+    using namespace std;
+    scoped_lock lock{mutex};
+    for (size_t first = 0; first < count; first += capacity) {
+      const auto chunk = min(capacity, count - first);
+      copy_n(&x[n * first], n * chunk, parameters);
+      run(chunk);
+      copy_n(objectives, m * chunk, &y[m * first]);
+    }
+  }
+
+ private:
+  /// Shared control block. 'cursor' stores the batch generation in its upper
+  /// and the next unprocessed slot in its lower 32 bits. Embedding the
+  /// generation and closing the cursor after every batch guarantees that
+  /// workers never take slots of a batch that has not been published yet.
+  /// Every member lives on its own cache line.
+  struct control {
+    alignas(64) std::atomic<uint64_t> cursor{0};
+    alignas(64) std::atomic<uint32_t> count{0};
+    alignas(64) std::atomic<uint32_t> generation{0};
+    alignas(64) std::atomic<uint32_t> done{0};
+    alignas(64) std::atomic<uint32_t> failed{0};
+    alignas(64) std::atomic<uint32_t> stop{0};
+  };
+
+  static constexpr uint32_t closed = 0xffffffff;
+
+  static constexpr size_t round_up(size_t x, size_t a) noexcept {
+    return (x + a - 1) / a * a;
+  }
+
+  /// Main loop of every worker process
+  void work() {
+    using namespace std;
+    auto& c = *shared;
+    uint32_t seen = 0;
+    while (true) {
+      // Sleep until the next batch has been announced.
+      for (auto g = c.generation.load(memory_order_acquire); g == seen;
+           g = c.generation.load(memory_order_acquire))
+        futex(c.generation, FUTEX_WAIT, seen);
+      seen = c.generation.load(memory_order_acquire);
+      if (c.stop.load(memory_order_acquire)) return;
+
+      // Take slots until the batch has been fully distributed.
+      while (true) {
+        auto cursor = c.cursor.load(memory_order_acquire);
+        const auto index = uint32_t(cursor);
+        const auto count = c.count.load(memory_order_acquire);
+        if (index >= count) break;
+        if (!c.cursor.compare_exchange_weak(cursor, cursor + 1,
+                                            memory_order_acq_rel))
+          continue;
+
+        try {
+          problem.evaluate(span{&parameters[n * index], n},
+                           span{&objectives[m * index], m});
+        } catch (...) {
+          c.failed.store(1, memory_order_relaxed);
+        }
+        if (c.done.fetch_add(1, memory_order_acq_rel) + 1 == count)
+          futex(c.done, FUTEX_WAKE, 1);
+      }
+    }
+  }
+
+  /// Publishes the first 'count' slots as new batch and waits until all of
+  /// them have been evaluated. If a worker process has died, an exception is
+  /// thrown and the pool cannot be used anymore.
+  void run(size_t count) {
+    using namespace std;
+    if (broken)
+      throw runtime_error("process_pool: a worker process has terminated");
+
+    auto& c = *shared;
+    const auto generation = c.generation.load(memory_order_relaxed) + 1;
+    const auto batch = uint64_t(generation) << 32;
+    c.done.store(0, memory_order_relaxed);
+    c.count.store(uint32_t(count), memory_order_release);
+    c.cursor.store(batch, memory_order_release);
+    c.generation.store(generation, memory_order_release);
+    futex(c.generation, FUTEX_WAKE, INT32_MAX);
+
+    for (auto d = c.done.load(memory_order_acquire); d < count;
+         d = c.done.load(memory_order_acquire)) {
+      timespec timeout{0, 100'000'000};
+      futex(c.done, FUTEX_WAIT, d, &timeout);
+      if (!alive()) {
+        broken = true;
+        throw runtime_error("process_pool: a worker process has terminated");
+      }
+    }
+    c.cursor.store(batch | closed, memory_order_relaxed);
+
+    if (c.failed.exchange(0, memory_order_relaxed))
+      throw runtime_error(
+          "process_pool: evaluation in worker process has thrown an "
+          "exception");
+  }
+
+  /// Checks whether all worker processes are still running.
+  bool alive() {
+    for (auto& pid : workers) {
+      if (pid <= 0) return false;
+      int status;
+      if (waitpid(pid, &status, WNOHANG) == pid) {
+        pid = -1;
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// Stops and reaps all worker processes and releases the shared memory.
+  void shutdown() noexcept {
+    if (!memory || memory == MAP_FAILED) return;
+    auto& c = *shared;
+    c.stop.store(1, std::memory_order_release);
+    c.generation.fetch_add(1, std::memory_order_acq_rel);
+    futex(c.generation, FUTEX_WAKE, INT32_MAX);
+    for (auto pid : workers) {
+      if (pid <= 0) continue;
+      int status;
+      while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+      }
+    }
+    workers.clear();
+    shared->~control();
+    munmap(memory, size);
+    memory = nullptr;
+  }
+
+  problem_type problem;
+  size_t n;
+  size_t m;
+  size_t capacity;
+
+  void* memory = nullptr;
+  size_t size = 0;
+  size_t parameters_offset = 0;
+  size_t objectives_offset = 0;
+  control* shared = nullptr;
+  real* parameters = nullptr;
+  real* objectives = nullptr;
+
+  std::vector<pid_t> workers{};
+  bool broken = false;
+  std::mutex mutex{};
+};
+
+}  // namespace detail
+
+/// Problem Adapter Evaluating in Forked Worker Processes
+/// The given problem is evaluated by a pool of worker processes that are
+/// forked at construction. Every process owns its own copy of the problem.
+/// Hence, problems with global state that are not thread-safe can be
+/// evaluated in parallel. The adapter itself is a batch-evaluatable problem
+/// and can be given to every optimizer instead of the original problem.
+/// Copies share the same pool of processes. The processes are stopped when
+/// the last copy is destroyed. Only available on Linux.
+template <generic::problem T>
+class process_evaluator {
+ public:
+  using problem_type = T;
+  using real = typename problem_type::real;
+
+  /// Structure to provide easy intialization of the pool. The capacity gives
+  /// the number of samples that fit into shared memory at once.
+  struct configuration {
+    size_t processes = default_thread_count();
+    size_t capacity = 1024;
+  };
+
+  process_evaluator() = default;
+  explicit process_evaluator(problem_type p, configuration config = {})
+      : problem(p),
+        pool{std::make_shared<detail::process_pool<problem_type>>(
+            problem, config.processes, config.capacity)} {}
+
+  size_t parameter_count() const { return problem.parameter_count(); }
+  size_t objective_count() const { return problem.objective_count(); }
+  real box_min(size_t i) const { return problem.box_min(i); }
+  real box_max(size_t i) const { return problem.box_max(i); }
+
+  /// Returns the number of worker processes.
+  auto process_count() const noexcept { return pool->process_count(); }
+
+  /// Evaluates a single sample by the worker processes.
+  void evaluate(const auto& x, auto&& y) {
+    pool->evaluate(std::ranges::data(x), std::ranges::data(y), 1);
+  }
+
+  /// Evaluates many samples concurrently by the worker processes.
+  void evaluate_batch(std::span<const real> x, std::span<real> y) {
+    pool->evaluate(x.data(), y.data(), y.size() / problem.objective_count());
+  }
+
+ private:
+  problem_type problem{};
+  std::shared_ptr<detail::process_pool<problem_type>> pool{};
+};
+
+}  // namespace lyrahgames::pareto
@@ -0,0 +1,185 @@
+#pragma once
+#include <algorithm>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <vector>
+//
+#include <lyrahgames/pareto/domination.hpp>
+#include <lyrahgames/pareto/meta.hpp>
+
+namespace lyrahgames::pareto {
+
+/// Domination layers of a population for an arbitrary number of objectives
+/// that can be updated point by point. Points are referenced by their slot
+/// index into an external array of objectives with 'm' values per point.
+/// Like in efficient non-dominated sorting (ENS), every front is kept sorted
+/// lexicographically. Hence, a point can only be dominated by front members
+/// before and only dominate front members after its own position. Insertions
+/// and removals only touch the fronts whose members change.
+template <generic::real real>
+class ranked_population {
+ public:
+  static constexpr size_t unranked = std::numeric_limits<size_t>::max();
+
+  /// Removes all points and prepares ranks for the given number of slots.
+  void resize(size_t slots) {
+    fronts.clear();
+    fronts.reserve(slots);
+    ranks.assign(slots, unranked);
+  }
+
+  auto front_count() const noexcept { return fronts.size(); }
+  const auto& front(size_t k) const { return fronts[k]; }
+
+  /// Returns the index of the front containing the given slot.
+  auto rank(size_t index) const noexcept { return ranks[index]; }
+  bool contains(size_t index) const noexcept {
+    return ranks[index] != unranked;
+  }
+
+  /// Inserts the point with the given index into its domination layer and
+  /// moves all points that are now dominated one layer further.
+  void insert(const real* y, size_t m, size_t index) {
+    using namespace std;
+    const auto point = [&](size_t i) { return span{&y[m * i], m}; };
+
+    // Binary search for the first front not dominating the point. Only front
+    // members lexicographically smaller than the point can dominate it.
+    size_t first = 0;
+    size_t last = fronts.size();
+    while (first < last) {
+      const auto mid = (first + last) / 2;
+      const auto& f = fronts[mid];
+      const auto end = lower_bound(y, m, f, index);
+      if (any_of(f.begin(), end,
+                 [&](auto q) { return dominates(point(q), point(index)); }))
+        first = mid + 1;
+      else
+        last = mid;
+    }
+
+    moving.assign(1, index);
+    for (auto k = first; !moving.empty(); ++k) {
+      if (k == fronts.size()) fronts.emplace_back();
+      auto& f = fronts[k];
+      dominated.clear();
+      erase_if(f, [&](auto q) {
+        const auto result = ranges::any_of(
+            moving, [&](auto d) { return dominates(point(d), point(q)); });
+        if (result) dominated.push_back(q);
+        return result;
+      });
+      merge(y, m, k, moving);
+      swap(moving, dominated);
+    }
+  }
+
+  /// Removes the point with the given index from its domination layer and
+  /// moves all points that are no longer dominated one layer forward. The
+  /// objectives of the removed point must still be valid during the call.
+  void remove(const real* y, size_t m, size_t index) {
+    using namespace std;
+    const auto point = [&](size_t i) { return span{&y[m * i], m}; };
+
+    auto k = ranks[index];
+    erase(fronts[k], index);
+    ranks[index] = unranked;
+
+    // Only points dominated by a point leaving a front may follow it.
+    moving.assign(1, index);
+    for (; k + 1 < fronts.size() && !moving.empty(); ++k) {
+      const auto dominated_by = [&](const auto& points, size_t q) {
+        return ranges::any_of(
+            points, [&](auto d) { return dominates(point(d), point(q)); });
+      };
+      dominated.clear();
+      erase_if(fronts[k + 1], [&](auto q) {
+        const auto result =
+            dominated_by(moving, q) && !dominated_by(fronts[k], q);
+        if (result) dominated.push_back(q);
+        return result;
+      });
+      merge(y, m, k, dominated);
+      swap(moving, dominated);
+    }
+    while (!fronts.empty() && fronts.back().empty())
+      fronts.pop_back();
+  }
+
+  /// Removes the point at the given position of the last front and returns
+  /// its index.
+  size_t remove_from_last_front(size_t position) {
+    auto& f = fronts.back();
+    const auto index = f[position];
+    f.erase(f.begin() + position);
+    ranks[index] = unranked;
+    if (f.empty()) fronts.pop_back();
+    return index;
+  }
+
+  /// Removes the point of the last front with the smallest crowding distance
+  /// and returns its index. Boundary points of every objective have an
+  /// infinite crowding distance.
+  size_t remove_least_crowded(const real* y, size_t m) {
+    using namespace std;
+    const auto& f = fronts.back();
+    if (f.size() <= 2) return remove_from_last_front(0);
+
+    order.resize(f.size());
+    distances.assign(f.size(), 0);
+    constexpr auto inf = numeric_limits<real>::infinity();
+    for (size_t v = 0; v < m; ++v) {
+      for (size_t i = 0; i < f.size(); ++i)
+        order[i] = i;
+      sort(order.begin(), order.end(),
+           [&](auto a, auto b) { return y[m * f[a] + v] < y[m * f[b] + v]; });
+      const auto low = y[m * f[order.front()] + v];
+      const auto high = y[m * f[order.back()] + v];
+      distances[order.front()] = inf;
+      distances[order.back()] = inf;
+      if (!(high > low)) continue;
+      const auto scale = 1 / (high - low);
+      for (size_t i = 1; i + 1 < f.size(); ++i)
+        distances[order[i]] +=
+            scale * (y[m * f[order[i + 1]] + v] - y[m * f[order[i - 1]] + v]);
+    }
+    return remove_from_last_front(
+        min_element(distances.begin(), distances.end()) - distances.begin());
+  }
+
+ private:
+  static bool less(const real* y, size_t m, size_t i, size_t j) {
+    return std::lexicographical_compare(&y[m * i], &y[m * (i + 1)], &y[m * j],
+                                        &y[m * (j + 1)]);
+  }
+
+  /// Returns the first position of the given front whose point is not
+  /// lexicographically smaller than the point with the given index.
+  static auto lower_bound(const real* y,
+                          size_t m,
+                          const std::vector<size_t>& f,
+                          size_t index) {
+    return std::lower_bound(f.begin(), f.end(), index, [&](auto i, auto j) {
+      return less(y, m, i, j);
+    });
+  }
+
+  /// Inserts the given points into front 'k' by keeping its order.
+  void merge(const real* y, size_t m, size_t k, std::vector<size_t>& points) {
+    auto& f = fronts[k];
+    for (auto index : points) {
+      f.insert(lower_bound(y, m, f, index), index);
+      ranks[index] = k;
+    }
+  }
+
+  std::vector<std::vector<size_t>> fronts{};
+  std::vector<size_t> ranks{};
+  std::vector<size_t> moving{};
+  std::vector<size_t> dominated{};
+  std::vector<size_t> order{};
+  std::vector<real> distances{};
+};
+
+}  // namespace lyrahgames::pareto
@@ -0,0 +1,68 @@
+#pragma once
+#include <vector>
+//
+#include <lyrahgames/pareto/meta.hpp>
+
+namespace lyrahgames::pareto {
+
+/// Returns the structured reference points of Das and Dennis on the unit
+/// simplex with 'm' coordinates. Every coordinate is a multiple of
+/// 1 / 'divisions' and all coordinates of a point sum up to one. The points
+/// are stored contiguously with 'm' values per point. Their count is given by
+/// the binomial coefficient (divisions + m - 1) over (m - 1).
+template <generic::real real>
+auto simplex_lattice(size_t m, size_t divisions) {
+  std::vector<real> result{};
+  if (m == 0) return result;
+  std::vector<size_t> parts(m, 0);
+
+  // Recursively distribute the remaining divisions over the coordinates.
+  const auto distribute = [&](auto&& self, size_t j, size_t remaining) {
+    if (j == m - 1) {
+      parts[j] = remaining;
+      for (auto p : parts)
+        result.push_back(divisions ? real(p) / divisions : real(1) / m);
+      return;
+    }
+    for (size_t p = 0; p <= remaining; ++p) {
+      parts[j] = p;
+      self(self, j + 1, remaining - p);
+    }
+  };
+  distribute(distribute, 0, divisions);
+  return result;
+}
+
+/// Returns two-layered structured reference points for many-objective
+/// problems. The outer layer is the simplex lattice with 'outer' divisions.
+/// The inner layer is the simplex lattice with 'inner' divisions shrunk by a
+/// factor of one half towards the center of the simplex. If 'inner' is zero,
+/// only the outer layer is returned.
+template <generic::real real>
+auto reference_points(size_t m, size_t outer, size_t inner = 0) {
+  auto result = simplex_lattice<real>(m, outer);
+  if (inner == 0) return result;
+  constexpr real scale = 0.5;
+  const auto shift = (1 - scale) / m;
+  for (auto w : simplex_lattice<real>(m, inner))
+    result.push_back(shift + scale * w);
+  return result;
+}
+
+/// Returns the largest number of divisions, but at least one, whose simplex
+/// lattice with 'm' coordinates has at most 'count' points.
+inline size_t simplex_divisions(size_t m, size_t count) {
+  const auto points = [m](size_t divisions) {
+    // Binomial coefficient (divisions + m - 1) over (m - 1) computed stepwise
+    double result = 1;
+    for (size_t i = 1; i < m; ++i)
+      result = result * double(divisions + i) / double(i);
+    return result;
+  };
+  size_t divisions = 1;
+  while (points(divisions + 1) <= double(count))
+    ++divisions;
+  return divisions;
+}
+
+}  // namespace lyrahgames::pareto
@@ -0,0 +1,633 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+//
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+//
+#include <lyrahgames/pareto/meta.hpp>
+#include <lyrahgames/pareto/tracing.hpp>
+
+namespace lyrahgames::pareto {
+
+namespace detail {
+
+/// Frame Header of the Remote Evaluation Protocol
+/// Every frame consists of this header followed by its payload. An 'evaluate'
+/// frame carries 'rows' parameter vectors of 'width' reals. The answering
+/// 'result' frame carries the same number of objective vectors and repeats the
+/// request's 'id'. Results may arrive in any order. An 'error' frame carries a
+/// message of 'rows' bytes. All values are stored in host byte order.
+struct remote_frame {
+  static constexpr uint32_t magic_number = 0x5645504c;  // "LPEV"
+  enum : uint32_t { evaluate = 1, result = 2, error = 3 };
+
+  uint32_t magic = magic_number;
+  uint32_t type = evaluate;
+  uint64_t id = 0;
+  uint32_t rows = 0;
+  uint32_t width = 0;
+  uint32_t real_size = 0;
+  uint32_t reserved = 0;
+};
+static_assert(sizeof(remote_frame) == 32);
+
+/// Closes the given file descriptor on destruction.
+class socket_handle {
+ public:
+  socket_handle() = default;
+  explicit socket_handle(int fd) noexcept : fd{fd} {}
+  socket_handle(socket_handle&& x) noexcept : fd{x.release()} {}
+  socket_handle& operator=(socket_handle&& x) noexcept {
+    std::swap(fd, x.fd);
+    return *this;
+  }
+  ~socket_handle() {
+    if (fd >= 0) ::close(fd);
+  }
+
+  int get() const noexcept { return fd; }
+  int release() noexcept { return std::exchange(fd, -1); }
+
+ private:
+  int fd = -1;
+};
+
+[[noreturn]] inline void throw_socket_error(const char* what) {
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+/// Writes the header and the payload of a frame completely.
+inline void send_frame(int fd,
+                       const remote_frame& header,
+                       const void* payload,
+                       size_t size) {
+  iovec parts[2] = {{const_cast<remote_frame*>(&header), sizeof(header)},
+                    {const_cast<void*>(payload), size}};
+  iovec* part = parts;
+  int count = (size > 0) ? 2 : 1;
+  while (count > 0) {
+    msghdr message{};
+    message.msg_iov = part;
+    message.msg_iovlen = count;
+    const auto written = ::sendmsg(fd, &message, MSG_NOSIGNAL);
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      throw_socket_error("remote evaluation: failed to send frame");
+    }
+    // Skip everything that has been written.
+    auto rest = size_t(written);
+    while (count > 0 && rest >= part->iov_len) {
+      rest -= part->iov_len;
+      ++part;
+      --count;
+    }
+    if (count > 0) {
+      part->iov_base = static_cast<char*>(part->iov_base) + rest;
+      part->iov_len -= rest;
+    }
+  }
+}
+
+/// Reads exactly 'size' bytes. Returns false if the peer closed the
+/// connection before the first byte. Throws if it was closed in between.
+inline bool receive_all(int fd, void* data, size_t size) {
+  auto first = static_cast<char*>(data);
+  size_t done = 0;
+  while (done < size) {
+    const auto count = ::recv(fd, first + done, size - done, 0);
+    if (count < 0) {
+      if (errno == EINTR) continue;
+      throw_socket_error("remote evaluation: failed to receive frame");
+    }
+    if (count == 0) {
+      if (done == 0) return false;
+      throw std::runtime_error("remote evaluation: connection closed early");
+    }
+    done += count;
+  }
+  return true;
+}
+
+/// Splits an address of the form '<host>:<port>' into its parts.
+inline auto split_address(const std::string& address) {
+  const auto colon = address.rfind(':');
+  if (colon == std::string::npos)
+    throw std::invalid_argument(
+        "remote evaluation: address '" + address +
+        "' is neither 'unix:<path>' nor '<host>:<port>'");
+  return std::pair{address.substr(0, colon), address.substr(colon + 1)};
+}
+
+/// Returns the Unix socket address for a 'unix:<path>' address.
+inline auto unix_address(const std::string& address) {
+  sockaddr_un result{};
+  result.sun_family = AF_UNIX;
+  const auto path = address.substr(5);
+  if (path.size() >= sizeof(result.sun_path))
+    throw std::invalid_argument("remote evaluation: Unix socket path '" +
+                                path + "' is too long");
+  std::memcpy(result.sun_path, path.c_str(), path.size() + 1);
+  return result;
+}
+
+/// Opens a connection to the given address which is either 'unix:<path>' for
+/// Unix domain sockets or '<host>:<port>' for TCP.
+inline socket_handle connect_socket(const std::string& address) {
+  if (address.starts_with("unix:")) {
+    socket_handle fd{::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)};
+    if (fd.get() < 0) throw_socket_error("remote evaluation: socket");
+    const auto target = unix_address(address);
+    if (::connect(fd.get(), reinterpret_cast<const sockaddr*>(&target),
+                  sizeof(target)) < 0)
+      throw_socket_error("remote evaluation: failed to connect");
+    return fd;
+  }
+
+  const auto [host, port] = split_address(address);
+  addrinfo hints{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo* list = nullptr;
+  if (const auto error = ::getaddrinfo(host.c_str(), port.c_str(), &hints,
+                                       &list))
+    throw std::runtime_error("remote evaluation: failed to resolve '" +
+                             address + "': " + ::gai_strerror(error));
+  std::unique_ptr<addrinfo, decltype(&::freeaddrinfo)> guard{list,
+                                                             ::freeaddrinfo};
+  for (auto info = list; info; info = info->ai_next) {
+    socket_handle fd{
+        ::socket(info->ai_family, info->ai_socktype | SOCK_CLOEXEC, 0)};
+    if (fd.get() < 0) continue;
+    if (::connect(fd.get(), info->ai_addr, info->ai_addrlen) < 0) continue;
+    // Small frames must not wait for further data.
+    int yes = 1;
+    ::setsockopt(fd.get(), IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+    return fd;
+  }
+  throw_socket_error("remote evaluation: failed to connect");
+}
+
+/// Binds a listening socket to the given address. For TCP, an empty host or
+/// '*' listens on all interfaces and port zero chooses a free port.
+inline socket_handle listen_socket(const std::string& address) {
+  if (address.starts_with("unix:")) {
+    socket_handle fd{::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)};
+    if (fd.get() < 0) throw_socket_error("remote evaluation: socket");
+    const auto target = unix_address(address);
+    ::unlink(target.sun_path);
+    if (::bind(fd.get(), reinterpret_cast<const sockaddr*>(&target),
+               sizeof(target)) < 0)
+      throw_socket_error("remote evaluation: failed to bind");
+    if (::listen(fd.get(), SOMAXCONN) < 0)
+      throw_socket_error("remote evaluation: failed to listen");
+    return fd;
+  }
+
+  const auto [host, port] = split_address(address);
+  addrinfo hints{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_flags = AI_PASSIVE;
+  addrinfo* list = nullptr;
+  const auto node = (host.empty() || host == "*") ? nullptr : host.c_str();
+  if (const auto error = ::getaddrinfo(node, port.c_str(), &hints, &list))
+    throw std::runtime_error("remote evaluation: failed to resolve '" +
+                             address + "': " + ::gai_strerror(error));
+  std::unique_ptr<addrinfo, decltype(&::freeaddrinfo)> guard{list,
+                                                             ::freeaddrinfo};
+  for (auto info = list; info; info = info->ai_next) {
+    socket_handle fd{
+        ::socket(info->ai_family, info->ai_socktype | SOCK_CLOEXEC, 0)};
+    if (fd.get() < 0) continue;
+    int yes = 1;
+    ::setsockopt(fd.get(), SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+    if (::bind(fd.get(), info->ai_addr, info->ai_addrlen) < 0) continue;
+    if (::listen(fd.get(), SOMAXCONN) < 0) continue;
+    return fd;
+  }
+  throw_socket_error("remote evaluation: failed to listen");
+}
+
+/// Client side of a remote evaluation connection. Submitted rows are
+/// collected into requests of at most 'batch' rows. At most 'pipeline'
+/// requests are in flight at the same time. Responses are matched to their
+/// requests by identifier and their objectives are received directly into the
+/// destinations given at submission.
+template <generic::real real>
+class remote_connection {
+ public:
+  remote_connection(const std::string& address,
+                    size_t n,
+                    size_t m,
+                    size_t batch,
+                    size_t pipeline)
+      : fd{connect_socket(address)},
+        n{n},
+        m{m},
+        batch{std::max<size_t>(1, batch)},
+        pipeline{std::max<size_t>(1, pipeline)} {
+    buffer.reserve(n * this->batch);
+  }
+
+  void submit(const real* x, real* y, size_t rows) {
+    std::scoped_lock lock{mutex};
+    for (size_t i = 0; i < rows;) {
+      const auto take = std::min(rows - i, batch - buffered);
+      buffer.insert(buffer.end(), &x[n * i], &x[n * (i + take)]);
+      destinations.push_back({&y[m * i], take});
+      buffered += take;
+      i += take;
+      if (buffered == batch) flush();
+    }
+  }
+
+  void wait() {
+    LYRAHGAMES_PARETO_TRACE_SCOPE("remote::wait");
+    std::scoped_lock lock{mutex};
+    flush();
+    while (!pending.empty())
+      receive();
+    if (!error.empty())
+      throw std::runtime_error(
+          "remote evaluation: " + std::exchange(error, std::string{}));
+  }
+
+ private:
+  /// Consecutive rows of a request sharing one contiguous destination
+  struct destination {
+    real* objectives;
+    size_t rows;
+  };
+
+  /// Sends all buffered rows as one request.
+  void flush() {
+    if (buffered == 0) return;
+    while (pending.size() >= pipeline)
+      receive();
+    const remote_frame header{.type = remote_frame::evaluate,
+                              .id = next_id,
+                              .rows = uint32_t(buffered),
+                              .width = uint32_t(n),
+                              .real_size = sizeof(real)};
+    send_frame(fd.get(), header, buffer.data(), buffer.size() * sizeof(real));
+    pending.emplace(next_id++, std::move(destinations));
+    destinations.clear();
+    buffer.clear();
+    buffered = 0;
+
+    // Collect already available responses without blocking.
+    while (!pending.empty() && readable())
+      receive();
+  }
+
+  bool readable() const {
+    pollfd entry{fd.get(), POLLIN, 0};
+    return ::poll(&entry, 1, 0) > 0;
+  }
+
+  /// Blocks until one response has been received.
+  void receive() {
+    remote_frame header{};
+    if (!receive_all(fd.get(), &header, sizeof(header)))
+      throw std::runtime_error("remote evaluation: connection closed");
+    if (header.magic != remote_frame::magic_number)
+      throw std::runtime_error("remote evaluation: invalid frame");
+    const auto it = pending.find(header.id);
+    if (it == pending.end())
+      throw std::runtime_error("remote evaluation: unknown request identifier");
+    auto targets = std::move(it->second);
+    pending.erase(it);
+
+    if (header.type == remote_frame::error) {
+      std::string message(header.rows, '\0');
+      receive_all(fd.get(), message.data(), message.size());
+      if (error.empty()) error = message;
+      return;
+    }
+
+    size_t rows = 0;
+    for (const auto& target : targets)
+      rows += target.rows;
+    if (header.type != remote_frame::result || header.rows != rows ||
+        header.width != m || header.real_size != sizeof(real))
+      throw std::runtime_error("remote evaluation: invalid result frame");
+    for (const auto& target : targets)
+      receive_all(fd.get(), target.objectives, target.rows * m * sizeof(real));
+  }
+
+  socket_handle fd;
+  size_t n;
+  size_t m;
+  size_t batch;
+  size_t pipeline;
+
+  std::vector<real> buffer{};
+  std::vector<destination> destinations{};
+  size_t buffered = 0;
+  uint64_t next_id = 0;
+  std::unordered_map<uint64_t, std::vector<destination>> pending{};
+  std::string error{};
+  std::mutex mutex{};
+};
+
+}  // namespace detail
+
+/// Problem Adapter Evaluating on a Remote Server
+/// The counts and box constraints are taken from the given local problem
+/// instance while all evaluations are sent to a server speaking the remote
+/// evaluation protocol, like 'remote_server'. Submitted samples are batched
+/// into requests and several requests are kept in flight such that network
+/// round trips overlap with the work of the optimizer. Copies share the same
+/// connection. Only available on POSIX systems.
+template <generic::problem T>
+class remote_evaluator {
+ public:
+  using problem_type = T;
+  using real = typename problem_type::real;
+
+  /// Structure to provide easy intialization of the connection. 'batch' gives
+  /// the maximum number of samples per request and 'pipeline' the maximum
+  /// number of requests in flight.
+  struct configuration {
+    size_t batch = 256;
+    size_t pipeline = 4;
+  };
+
+  remote_evaluator() = default;
+  remote_evaluator(problem_type p,
+                   const std::string& address,
+                   configuration config = {})
+      : problem(p),
+        connection{std::make_shared<detail::remote_connection<real>>(
+            address, problem.parameter_count(), problem.objective_count(),
+            config.batch, config.pipeline)} {}
+
+  size_t parameter_count() const { return problem.parameter_count(); }
+  size_t objective_count() const { return problem.objective_count(); }
+  real box_min(size_t i) const { return problem.box_min(i); }
+  real box_max(size_t i) const { return problem.box_max(i); }
+
+  /// Hands the contiguously stored samples over for evaluation. The objectives
+  /// are written after 'wait' returned. The memory of 'y' has to stay valid.
+  void submit(std::span<const real> x, std::span<real> y) {
+    connection->submit(x.data(), y.data(), y.size() / objective_count());
+  }
+
+  /// Waits until all submitted samples have been evaluated.
+  void wait() { connection->wait(); }
+
+  void evaluate_batch(std::span<const real> x, std::span<real> y) {
+    submit(x, y);
+    wait();
+  }
+
+  void evaluate(const auto& x, auto&& y) {
+    connection->submit(std::ranges::data(x), std::ranges::data(y), 1);
+    wait();
+  }
+
+ private:
+  problem_type problem{};
+  std::shared_ptr<detail::remote_connection<real>> connection{};
+};
+
+/// Reference Server of the Remote Evaluation Protocol
+/// Evaluates the requests of every client connection with the given problem.
+/// For more than one thread, requests of a connection are evaluated
+/// concurrently by threads with their own copy of the problem and results are
+/// sent in order of completion.
+template <generic::problem T>
+class remote_server {
+ public:
+  using problem_type = T;
+  using real = typename problem_type::real;
+
+  struct configuration {
+    size_t threads = 1;
+  };
+
+  remote_server(problem_type p,
+                const std::string& address,
+                configuration config = {})
+      : problem(p),
+        listener{detail::listen_socket(address)},
+        threads{std::max<size_t>(1, config.threads)} {
+    if (address.starts_with("unix:")) {
+      bound = address;
+      return;
+    }
+    sockaddr_storage storage{};
+    socklen_t size = sizeof(storage);
+    ::getsockname(listener.get(), reinterpret_cast<sockaddr*>(&storage),
+                  &size);
+    const auto port = (storage.ss_family == AF_INET6)
+                          ? reinterpret_cast<sockaddr_in6&>(storage).sin6_port
+                          : reinterpret_cast<sockaddr_in&>(storage).sin_port;
+    bound = detail::split_address(address).first + ":" +
+            std::to_string(ntohs(port));
+  }
+
+  remote_server(const remote_server&) = delete;
+  remote_server& operator=(const remote_server&) = delete;
+
+  ~remote_server() { stop(); }
+
+  /// Returns the address clients should connect to. For TCP, the port is the
+  /// actually bound one.
+  const std::string& address() const noexcept { return bound; }
+
+  /// Accepts and serves connections until 'stop' is called.
+  void serve() {
+    while (!stopped) {
+      const auto fd = ::accept4(listener.get(), nullptr, nullptr, SOCK_CLOEXEC);
+      if (fd < 0) {
+        if (errno == EINTR || errno == ECONNABORTED) continue;
+        break;
+      }
+      int yes = 1;
+      ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+      std::scoped_lock lock{mutex};
+      if (stopped) {
+        ::close(fd);
+        break;
+      }
+      connections.push_back(fd);
+      handlers.emplace_back([this, fd] { handle(fd); });
+    }
+  }
+
+  /// Stops accepting and closes all connections. Can be called from any
+  /// thread.
+  void stop() {
+    {
+      std::scoped_lock lock{mutex};
+      if (stopped.exchange(true)) return;
+      ::shutdown(listener.get(), SHUT_RDWR);
+      for (auto fd : connections)
+        ::shutdown(fd, SHUT_RDWR);
+    }
+    for (auto& handler : handlers)
+      handler.join();
+  }
+
+ private:
+  /// Request waiting for its evaluation
+  struct job {
+    uint64_t id;
+    size_t rows;
+    std::vector<real> parameters;
+  };
+
+  /// Evaluates the given job and sends its result or an error message.
+  void process(problem_type& local, job& task, int fd, std::mutex& output) {
+    const auto n = local.parameter_count();
+    const auto m = local.objective_count();
+    std::vector<real> objectives(m * task.rows);
+    std::string error{};
+    try {
+      for (size_t i = 0; i < task.rows; ++i)
+        local.evaluate(std::span{&task.parameters[n * i], n},
+                       std::span{&objectives[m * i], m});
+    } catch (std::exception& e) {
+      error = e.what();
+    } catch (...) {
+      error = "unknown exception";
+    }
+    std::scoped_lock lock{output};
+    if (error.empty())
+      detail::send_frame(fd,
+                         {.type = detail::remote_frame::result,
+                          .id = task.id,
+                          .rows = uint32_t(task.rows),
+                          .width = uint32_t(m),
+                          .real_size = sizeof(real)},
+                         objectives.data(), objectives.size() * sizeof(real));
+    else
+      detail::send_frame(fd,
+                         {.type = detail::remote_frame::error,
+                          .id = task.id,
+                          .rows = uint32_t(error.size()),
+                          .width = 1,
+                          .real_size = 1},
+                         error.data(), error.size());
+  }
+
+  /// Serves one client connection until it is closed.
+  void handle(int fd) {
+    std::mutex output{};
+    std::mutex queue_mutex{};
+    std::condition_variable ready{};
+    std::deque<job> queue{};
+    bool closed = false;
+
+    // Workers evaluating requests concurrently with their own problem copy
+    std::vector<std::thread> workers{};
+    if (threads > 1) {
+      for (size_t t = 0; t < threads; ++t)
+        workers.emplace_back([&, local = problem]() mutable {
+          while (true) {
+            std::unique_lock lock{queue_mutex};
+            ready.wait(lock, [&] { return closed || !queue.empty(); });
+            if (queue.empty()) return;
+            auto task = std::move(queue.front());
+            queue.pop_front();
+            lock.unlock();
+            try {
+              process(local, task, fd, output);
+            } catch (...) {
+              ::shutdown(fd, SHUT_RDWR);
+            }
+          }
+        });
+    }
+
+    try {
+      auto local = problem;
+      const auto n = local.parameter_count();
+      detail::remote_frame header{};
+      while (detail::receive_all(fd, &header, sizeof(header))) {
+        if (header.magic != detail::remote_frame::magic_number ||
+            header.type != detail::remote_frame::evaluate)
+          break;
+        // Requests not matching the problem are answered with an error.
+        if (header.width != n || header.real_size != sizeof(real)) {
+          std::vector<char> ignored(size_t(header.rows) * header.width *
+                                    header.real_size);
+          detail::receive_all(fd, ignored.data(), ignored.size());
+          const std::string error = "request does not match the problem";
+          std::scoped_lock lock{output};
+          detail::send_frame(fd,
+                             {.type = detail::remote_frame::error,
+                              .id = header.id,
+                              .rows = uint32_t(error.size()),
+                              .width = 1,
+                              .real_size = 1},
+                             error.data(), error.size());
+          continue;
+        }
+        job task{header.id, header.rows, {}};
+        task.parameters.resize(size_t(header.rows) * n);
+        detail::receive_all(fd, task.parameters.data(),
+                            task.parameters.size() * sizeof(real));
+        if (threads == 1) {
+          process(local, task, fd, output);
+          continue;
+        }
+        {
+          std::scoped_lock lock{queue_mutex};
+          queue.push_back(std::move(task));
+        }
+        ready.notify_one();
+      }
+    } catch (...) {
+      // A broken connection only ends this connection.
+    }
+
+    {
+      std::scoped_lock lock{queue_mutex};
+      closed = true;
+    }
+    ready.notify_all();
+    for (auto& worker : workers)
+      worker.join();
+
+    std::scoped_lock lock{mutex};
+    std::erase(connections, fd);
+    ::close(fd);
+  }
+
+  problem_type problem;
+  detail::socket_handle listener;
+  size_t threads;
+  std::string bound{};
+
+  std::atomic<bool> stopped{false};
+  std::mutex mutex{};
+  std::vector<int> connections{};
+  std::vector<std::thread> handlers{};
+};
+
+}  // namespace lyrahgames::pareto
@@ -0,0 +1,312 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+//
+#include <lyrahgames/pareto/meta.hpp>
+
+namespace lyrahgames::pareto {
+
+/// Methods to sample the parameter box of a problem
+enum class sampling { uniform, sobol, halton, latin_hypercube };
+
+namespace detail {
+
+/// Multiplies two polynomials over GF(2) modulo the polynomial 'p' of the
+/// given degree. Bit 'i' stores the coefficient of x^i.
+constexpr uint64_t gf2_multiply(uint64_t a,
+                                uint64_t b,
+                                uint64_t p,
+                                unsigned degree) noexcept {
+  uint64_t result = 0;
+  for (; b; b >>= 1) {
+    if (b & 1) result ^= a;
+    a <<= 1;
+    if (a >> degree & 1) a ^= p;
+  }
+  return result;
+}
+
+constexpr uint64_t gf2_power(uint64_t a,
+                             uint64_t e,
+                             uint64_t p,
+                             unsigned degree) noexcept {
+  uint64_t result = 1;
+  for (; e; e >>= 1) {
+    if (e & 1) result = gf2_multiply(result, a, p, degree);
+    a = gf2_multiply(a, a, p, degree);
+  }
+  return result;
+}
+
+/// Checks whether the given polynomial of the given degree is primitive over
+/// GF(2), i.e. whether x generates the multiplicative group of GF(2)[x]/p.
+constexpr bool primitive(uint64_t p, unsigned degree) noexcept {
+  const uint64_t order = (uint64_t{1} << degree) - 1;
+  const uint64_t x = (degree == 1) ? 1 : 2;
+  if (gf2_power(x, order, p, degree) != 1) return false;
+  // The order of x must not divide any maximal proper divisor of 2^d - 1.
+  auto rest = order;
+  for (uint64_t q = 2; q * q <= rest; ++q) {
+    if (rest % q) continue;
+    if (gf2_power(x, order / q, p, degree) == 1) return false;
+    while (rest % q == 0)
+      rest /= q;
+  }
+  return rest == 1 || gf2_power(x, order / rest, p, degree) != 1;
+}
+
+/// Returns the first 'count' primitive polynomials over GF(2) ordered by their
+/// degree and value.
+inline auto primitive_polynomials(size_t count) {
+  std::vector<uint64_t> result{};
+  result.reserve(count);
+  for (unsigned degree = 1; result.size() < count; ++degree)
+    for (uint64_t p = (uint64_t{1} << degree) | 1;
+         p < (uint64_t{2} << degree) && result.size() < count; p += 2)
+      if (primitive(p, degree)) result.push_back(p);
+  return result;
+}
+
+/// Maps 32 random bits to [0, 1) without rounding up to one.
+template <generic::real real>
+constexpr real unit_interval(uint32_t bits) noexcept {
+  constexpr int digits = std::min(32, std::numeric_limits<real>::digits);
+  return real(bits >> (32 - digits)) * std::ldexp(real(1), -digits);
+}
+
+}  // namespace detail
+
+/// Scrambled Sobol Sequence in the Unit Cube
+/// Direction numbers are built from primitive polynomials over GF(2) that are
+/// generated on construction. Their free initial values are chosen
+/// deterministically for every dimension. The first dimension is the van der
+/// Corput sequence. Consecutive points are generated in Gray code order by
+/// one XOR per coordinate. Scrambling applies a random digital shift to every
+/// dimension that keeps the net properties of the sequence.
+template <generic::real real>
+class sobol_sequence {
+ public:
+  static constexpr size_t bits = 32;
+
+  sobol_sequence() = default;
+  explicit sobol_sequence(size_t dimension)
+      : d(dimension),
+        directions(bits * dimension),
+        state(dimension, 0),
+        shifts(dimension, 0) {
+    using namespace std;
+    if (d == 0) return;
+    for (size_t k = 0; k < bits; ++k)
+      directions[k * d] = uint32_t{1} << (bits - 1 - k);
+
+    const auto polynomials = detail::primitive_polynomials(d - 1);
+    mt19937 initial{5489};
+    uint32_t m[bits];
+    for (size_t j = 1; j < d; ++j) {
+      const auto p = polynomials[j - 1];
+      const auto degree = unsigned(bit_width(p) - 1);
+      // Free initial values have to be odd and smaller than 2^(k + 1).
+      for (size_t k = 0; k < min<size_t>(degree, bits); ++k)
+        m[k] = (initial() % (uint32_t{1} << k)) << 1 | 1;
+      for (size_t k = degree; k < bits; ++k) {
+        m[k] = m[k - degree] ^ (m[k - degree] << degree);
+        for (unsigned i = 1; i < degree; ++i)
+          if (p >> (degree - i) & 1) m[k] ^= m[k - i] << i;
+      }
+      for (size_t k = 0; k < bits; ++k)
+        directions[k * d + j] = m[k] << (bits - 1 - k);
+    }
+  }
+
+  auto dimension() const noexcept { return d; }
+
+  /// Draws a new random digital shift for every dimension.
+  void scramble(generic::random_number_generator auto&& rng) {
+    std::uniform_int_distribution<uint32_t> distribution{};
+    for (auto& shift : shifts)
+      shift = distribution(rng);
+  }
+
+  /// Skips ahead to the point with the given index.
+  void seek(uint64_t index) {
+    position = index;
+    std::fill(state.begin(), state.end(), 0);
+    const auto gray = index ^ (index >> 1);
+    for (size_t k = 0; k < bits; ++k)
+      if (gray >> k & 1)
+        for (size_t j = 0; j < d; ++j)
+          state[j] ^= directions[k * d + j];
+  }
+
+  /// Writes the next 'count' points contiguously to the given array.
+  void generate(size_t count, real* out) {
+    using namespace std;
+    for (size_t i = 0; i < count; ++i, out += d) {
+      for (size_t j = 0; j < d; ++j)
+        out[j] = detail::unit_interval<real>(state[j] ^ shifts[j]);
+      const auto k = size_t(countr_one(position++)) % bits;
+      const auto v = &directions[k * d];
+      for (size_t j = 0; j < d; ++j)
+        state[j] ^= v[j];
+    }
+  }
+
+ private:
+  size_t d = 0;
+  std::vector<uint32_t> directions{};
+  std::vector<uint32_t> state{};
+  std::vector<uint32_t> shifts{};
+  uint64_t position = 0;
+};
+
+/// Halton Sequence in the Unit Cube
+/// Every dimension uses the radical inverse with respect to its own prime
+/// base. The point with index zero is skipped.
+template <generic::real real>
+class halton_sequence {
+ public:
+  halton_sequence() = default;
+  explicit halton_sequence(size_t dimension) : bases(dimension) {
+    uint64_t candidate = 2;
+    for (auto& base : bases) {
+      const auto prime = [](uint64_t x) {
+        for (uint64_t q = 2; q * q <= x; ++q)
+          if (x % q == 0) return false;
+        return true;
+      };
+      while (!prime(candidate))
+        ++candidate;
+      base = candidate++;
+    }
+  }
+
+  auto dimension() const noexcept { return bases.size(); }
+
+  /// Skips ahead to the point with the given index.
+  void seek(uint64_t index) noexcept { position = index; }
+
+  /// Writes the next 'count' points contiguously to the given array.
+  void generate(size_t count, real* out) {
+    using namespace std;
+    const auto d = bases.size();
+    const auto limit = nextafter(real(1), real(0));
+    for (size_t i = 0; i < count; ++i, out += d) {
+      const auto index = ++position;
+      for (size_t j = 0; j < d; ++j) {
+        const auto b = bases[j];
+        double inverse = 1.0 / double(b);
+        double factor = inverse;
+        double result = 0;
+        for (auto k = index; k; k /= b, factor *= inverse)
+          result += factor * double(k % b);
+        out[j] = min(real(result), limit);
+      }
+    }
+  }
+
+ private:
+  std::vector<uint64_t> bases{};
+  uint64_t position = 0;
+};
+
+/// Writes a Latin hypercube design of 'count' points in the unit cube of the
+/// given dimension contiguously to the given array. Every dimension is divided
+/// into 'count' strata of which every one contains exactly one point. 'strata'
+/// is scratch memory that can be reused over calls.
+template <generic::real real>
+void latin_hypercube(size_t count,
+                     size_t dimension,
+                     real* out,
+                     generic::random_number_generator auto&& rng,
+                     std::vector<size_t>& strata) {
+  using namespace std;
+  uniform_real_distribution<real> distribution{0, 1};
+  const auto limit = nextafter(real(1), real(0));
+  strata.resize(count);
+  for (size_t j = 0; j < dimension; ++j) {
+    iota(strata.begin(), strata.end(), size_t{0});
+    shuffle(strata.begin(), strata.end(), rng);
+    for (size_t i = 0; i < count; ++i)
+      out[dimension * i + j] =
+          min((real(strata[i]) + distribution(rng)) / real(count), limit);
+  }
+}
+
+/// Generates samples inside the parameter box of a problem by one of the
+/// available sampling methods. Sequences continue over subsequent calls. The
+/// offset skips ahead in quasi-random sequences such that parallel workers
+/// can use disjoint parts of the same sequence. Latin hypercube designs are
+/// generated for every call separately.
+template <generic::real real>
+class sampler {
+ public:
+  sampler() = default;
+  sampler(sampling method, size_t dimension, uint64_t offset = 0)
+      : type(method), d(dimension) {
+    if (type == sampling::sobol) {
+      sobol = sobol_sequence<real>{d};
+      sobol.seek(offset);
+    } else if (type == sampling::halton) {
+      halton = halton_sequence<real>{d};
+      halton.seek(offset);
+    }
+  }
+
+  auto method() const noexcept { return type; }
+
+  /// Writes 'count' samples in the unit cube contiguously to the given array.
+  /// The random number generator is used for uniform and Latin hypercube
+  /// samples and to scramble the Sobol sequence on first use.
+  void generate(size_t count,
+                real* out,
+                generic::random_number_generator auto&& rng) {
+    switch (type) {
+      case sampling::sobol:
+        if (!scrambled) sobol.scramble(rng);
+        scrambled = true;
+        sobol.generate(count, out);
+        break;
+      case sampling::halton:
+        halton.generate(count, out);
+        break;
+      case sampling::latin_hypercube:
+        latin_hypercube(count, d, out, rng, strata);
+        break;
+      default: {
+        std::uniform_real_distribution<real> distribution{0, 1};
+        for (size_t i = 0; i < count * d; ++i)
+          out[i] = distribution(rng);
+      }
+    }
+  }
+
+  /// Writes 'count' samples inside the parameter box of the given problem
+  /// contiguously to the given array.
+  void sample(const generic::problem auto& problem,
+              size_t count,
+              real* out,
+              generic::random_number_generator auto&& rng) {
+    using std::lerp;
+    generate(count, out, rng);
+    for (size_t i = 0; i < count; ++i)
+      for (size_t j = 0; j < d; ++j)
+        out[d * i + j] =
+            lerp(problem.box_min(j), problem.box_max(j), out[d * i + j]);
+  }
+
+ private:
+  sampling type = sampling::uniform;
+  size_t d = 0;
+  sobol_sequence<real> sobol{};
+  halton_sequence<real> halton{};
+  bool scrambled = false;
+  std::vector<size_t> strata{};
+};
+
+}  // namespace lyrahgames::pareto
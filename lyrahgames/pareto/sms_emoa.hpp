@@ -0,0 +1,434 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <set>
+#include <span>
+#include <utility>
+#include <vector>
+//
+#include <lyrahgames/pareto/domination.hpp>
+#include <lyrahgames/pareto/frontier_cast.hpp>
+#include <lyrahgames/pareto/hypervolume.hpp>
+#include <lyrahgames/pareto/meta.hpp>
+#include <lyrahgames/pareto/ranked_population.hpp>
+#include <lyrahgames/pareto/tracing.hpp>
+#include <lyrahgames/pareto/variation.hpp>
+
+namespace lyrahgames::pareto {
+
+namespace sms_emoa {
+
+/// Specialized Pareto Problems for the SMS-EMOA Algorithm
+template <typename T>
+concept problem = generic::evaluatable_problem<T,
+                                               std::span<typename T::real>,
+                                               std::span<typename T::real>>;
+
+/// Domination layers of a steady-state population for two objectives. Every
+/// front is stored as a balanced tree ordered by the first objective. Hence,
+/// domination checks against a whole front and the exclusive hypervolume
+/// contributions of its interior points can be maintained with logarithmic
+/// cost per inserted, moved, or removed point.
+template <generic::real real>
+class planar_fronts {
+ public:
+  void resize(size_t slots) {
+    fronts.clear();
+    contribution.assign(slots, nan);
+    marked.assign(slots, false);
+  }
+
+  auto front_count() const noexcept { return fronts.size(); }
+
+  /// Returns the indices of the points in the given front.
+  auto front(size_t k) const {
+    std::vector<size_t> result{};
+    for (auto [_, i] : fronts[k].points)
+      result.push_back(i);
+    return result;
+  }
+
+  /// Inserts the point with the given index into its domination layer and
+  /// moves all points that are now dominated one layer further.
+  void insert(const real* y, size_t index) {
+    using namespace std;
+
+    // Binary search for the first front not dominating the point.
+    size_t first = 0;
+    size_t last = fronts.size();
+    while (first < last) {
+      const auto mid = (first + last) / 2;
+      if (dominated_by(fronts[mid], y, index))
+        first = mid + 1;
+      else
+        last = mid;
+    }
+
+    vector<size_t> moving{index};
+    vector<size_t> dominated{};
+    for (auto k = first; !moving.empty(); ++k) {
+      if (k == fronts.size()) fronts.emplace_back();
+      auto& f = fronts[k];
+
+      // Collect all points of the front dominated by any moving point.
+      dominated.clear();
+      for (auto d : moving) {
+        auto it = f.points.lower_bound({y[2 * d], 0});
+        for (; it != f.points.end(); ++it) {
+          const auto q = it->second;
+          if (y[2 * q + 1] < y[2 * d + 1]) break;
+          if (y[2 * q] == y[2 * d] && y[2 * q + 1] == y[2 * d + 1]) break;
+          if (marked[q]) continue;
+          marked[q] = true;
+          dominated.push_back(q);
+        }
+      }
+      for (auto q : dominated) {
+        marked[q] = false;
+        erase(y, f, q);
+      }
+      for (auto d : moving)
+        emplace(y, f, d);
+      swap(moving, dominated);
+    }
+  }
+
+  /// Removes the point of the last front with the smallest exclusive
+  /// hypervolume contribution and returns its index. The reference point is
+  /// given by the nadir point of the last front shifted by 'offset'.
+  size_t remove_least_contributor(const real* y, real offset) {
+    using namespace std;
+    auto& f = fronts.back();
+    auto index = f.points.begin()->second;
+    if (f.points.size() > 1) {
+      const auto a = f.points.begin()->second;
+      const auto b = next(f.points.begin())->second;
+      const auto c = prev(f.points.end())->second;
+      const auto d = prev(f.points.end(), 2)->second;
+      auto best = (y[2 * b] - y[2 * a]) * offset;
+      index = a;
+      if (const auto value = offset * (y[2 * d + 1] - y[2 * c + 1]);
+          value < best) {
+        best = value;
+        index = c;
+      }
+      if (!f.contributions.empty() && f.contributions.begin()->first < best)
+        index = f.contributions.begin()->second;
+    }
+    erase(y, f, index);
+    if (f.points.empty()) fronts.pop_back();
+    return index;
+  }
+
+ private:
+  static constexpr auto npos = std::numeric_limits<size_t>::max();
+  static constexpr auto nan = std::numeric_limits<real>::quiet_NaN();
+
+  struct layer {
+    std::set<std::pair<real, size_t>> points{};
+    std::set<std::pair<real, size_t>> contributions{};
+  };
+
+  /// Checks if the point is dominated by any point of the given front. Only
+  /// the last point not exceeding the first objective has to be checked.
+  bool dominated_by(const layer& f, const real* y, size_t index) const {
+    auto it = f.points.upper_bound({y[2 * index], npos});
+    if (it == f.points.begin()) return false;
+    const auto q = std::prev(it)->second;
+    return (y[2 * q + 1] <= y[2 * index + 1]) &&
+           ((y[2 * q] < y[2 * index]) || (y[2 * q + 1] < y[2 * index + 1]));
+  }
+
+  /// Recomputes the exclusive contribution of an interior point.
+  void update(const real* y, layer& f, auto it) {
+    const auto index = it->second;
+    if (!std::isnan(contribution[index]))
+      f.contributions.erase({contribution[index], index});
+    contribution[index] = nan;
+    if (it == f.points.begin() || std::next(it) == f.points.end()) return;
+    const auto a = std::prev(it)->second;
+    const auto b = std::next(it)->second;
+    contribution[index] =
+        (y[2 * b] - y[2 * index]) * (y[2 * a + 1] - y[2 * index + 1]);
+    f.contributions.emplace(contribution[index], index);
+  }
+
+  void emplace(const real* y, layer& f, size_t index) {
+    const auto it = f.points.emplace(y[2 * index], index).first;
+    update(y, f, it);
+    if (it != f.points.begin()) update(y, f, std::prev(it));
+    if (std::next(it) != f.points.end()) update(y, f, std::next(it));
+  }
+
+  void erase(const real* y, layer& f, size_t index) {
+    if (!std::isnan(contribution[index]))
+      f.contributions.erase({contribution[index], index});
+    contribution[index] = nan;
+    auto it = f.points.erase(f.points.find({y[2 * index], index}));
+    if (it != f.points.end()) update(y, f, it);
+    if (it != f.points.begin()) update(y, f, std::prev(it));
+  }
+
+  std::vector<layer> fronts{};
+  std::vector<real> contribution{};
+  std::vector<char> marked{};
+};
+
+/// Domination layers of a steady-state population for an arbitrary number of
+/// objectives. The hypervolume contributions are computed for the last front
+/// on demand. For three objectives, this is done by one sweep that keeps the
+/// staircase of the current two-dimensional slice in a balanced tree and only
+/// updates the neighbors of every inserted point.
+template <generic::real real>
+class general_fronts : public ranked_population<real> {
+ public:
+  using base = ranked_population<real>;
+
+  /// Removes the point of the last front with the smallest exclusive
+  /// hypervolume contribution and returns its index. The reference point is
+  /// given by the nadir point of the last front shifted by 'offset'.
+  size_t remove_least_contributor(const real* y, size_t m, real offset) {
+    using namespace std;
+    const auto& f = base::front(base::front_count() - 1);
+    size_t k = 0;
+    if (f.size() > 1) {
+      points.resize(m * f.size());
+      reference.assign(m, -numeric_limits<real>::infinity());
+      for (size_t i = 0; i < f.size(); ++i)
+        for (size_t j = 0; j < m; ++j) {
+          points[m * i + j] = y[m * f[i] + j];
+          reference[j] = max(reference[j], points[m * i + j]);
+        }
+      for (auto& r : reference)
+        r += offset;
+      contributions.resize(f.size());
+      detail::hypervolume_contributions(points.data(), f.size(), m,
+                                        reference.data(), contributions.data());
+      k = min_element(contributions.begin(), contributions.end()) -
+          contributions.begin();
+    }
+    return base::remove_from_last_front(k);
+  }
+
+ private:
+  std::vector<real> points{};
+  std::vector<real> reference{};
+  std::vector<real> contributions{};
+};
+
+/// S-Metric Selection Evolutionary Multi-Objective Algorithm (SMS-EMOA)
+/// Steady-state algorithm that generates one offspring per iteration and
+/// discards the individual of the worst domination layer with the smallest
+/// exclusive hypervolume contribution. For two objectives, layers and
+/// contributions are updated incrementally with logarithmic cost. For three
+/// objectives, the contributions of a worst layer with 'k' points are computed
+/// with a complexity of O(k log k) per iteration.
+template <problem T>
+class optimizer {
+ public:
+  using problem_type = T;
+  using real = typename problem_type::real;
+
+  /// Structure to provide easy intialization of the parameters of the
+  /// algorithm. By using designated initializers, named function arguments can
+  /// be simulated. The iterations are given by the number of evaluations.
+  struct configuration {
+    size_t iterations = 100000;
+    size_t population = 100;
+    float crossover_ratio = 0.3;
+    float reference_offset = 1;
+  };
+
+  optimizer() = default;
+  explicit optimizer(problem_type p,
+                     generic::random_number_generator auto&& rng,
+                     configuration config = {})
+      : problem(p),
+        s(config.population),
+        iter(config.iterations),
+        crossover_probability(config.crossover_ratio),
+        offset(config.reference_offset) {
+    init();
+    init_population(std::forward<decltype(rng)>(rng));
+  }
+
+  void init() {
+    const auto n = problem.parameter_count();
+    const auto m = problem.objective_count();
+    // One additional slot is used to store the offspring.
+    parameters.resize(n * (s + 1));
+    objectives.resize(m * (s + 1));
+    planar.resize(s + 1);
+    general.resize(s + 1);
+  }
+
+  /// Clamp the parameters referenced by the given index to the box constraints
+  /// defined by the current problem.
+  void clamp(size_t index) {
+    using std::clamp;
+    const auto n = problem.parameter_count();
+    for (size_t i = 0; i < n; ++i)
+      parameters[n * index + i] = clamp(parameters[n * index + i],
+                                        problem.box_min(i), problem.box_max(i));
+  }
+
+  /// Evaluate all objectives at the given index by using the parameters
+  /// referenced by the given index.
+  void evaluate(size_t index) {
+    using std::span;
+    const auto n = problem.parameter_count();
+    const auto m = problem.objective_count();
+    problem.evaluate(
+        span{&parameters[n * index], &parameters[n * (index + 1)]},
+        span{&objectives[m * index], &objectives[m * (index + 1)]});
+  }
+
+  /// Generates a random population to start with the optimization algorithm.
+  void init_population(generic::random_number_generator auto&& rng) {
+    using namespace std;
+    const auto n = problem.parameter_count();
+
+    uniform_real_distribution<real> distribution{0, 1};
+    const auto random = [&] { return distribution(rng); };
+
+    for (size_t i = 0; i < s; ++i) {
+      for (size_t j = 0; j < n; ++j)
+        parameters[n * i + j] =
+            lerp(problem.box_min(j), problem.box_max(j), random());
+      evaluate(i);
+      insert(i);
+    }
+    free = s;
+  }
+
+  /// Generates and evaluates one offspring, inserts it into the population,
+  /// and discards the individual with the least hypervolume contribution of
+  /// the worst domination layer.
+  void step(generic::random_number_generator auto&& rng) {
+    LYRAHGAMES_PARETO_TRACE_SCOPE("sms_emoa::step");
+    using namespace std;
+
+    // Choose random parents out of the population by skipping the free slot.
+    uniform_int_distribution<size_t> distribution{0, s - 1};
+    const auto random = [&] {
+      const auto i = distribution(rng);
+      return (i < free) ? i : i + 1;
+    };
+
+    const auto n = problem.parameter_count();
+    const auto offspring = &parameters[n * free];
+    if (bernoulli_distribution{crossover_probability}(rng)) {
+      // The second offspring of the crossover is stored in scratch memory.
+      scratch.resize(n);
+      simulated_binary_crossover(n, &parameters[n * random()],
+                                 &parameters[n * random()], offspring,
+                                 scratch.data(), rng);
+    } else {
+      alternate_random_mutation(problem, &parameters[n * random()], offspring,
+                                rng);
+    }
+    clamp(free);
+    evaluate(free);
+    insert(free);
+    free = remove();
+  }
+
+  /// This function can be applied multiple times to further improve the
+  /// estimation of the Pareto frontier.
+  void optimize(generic::random_number_generator auto&& rng,
+                size_t iterations) {
+    for (size_t i = 0; i < iterations; ++i)
+      step(rng);
+  }
+
+  /// Uses the iterations count given by construction.
+  void optimize(generic::random_number_generator auto&& rng) {
+    optimize(std::forward<decltype(rng)>(rng), iter);
+  }
+
+  /// Casts the estimated Pareto points stored as an implementation detail into
+  /// a usable frontier data structure.
+  template <generic::frontier frontier_type>
+  auto frontier_cast() const {
+    using namespace std;
+    const auto n = problem.parameter_count();
+    const auto m = problem.objective_count();
+    vector<size_t> pareto{};
+    if (m == 2)
+      pareto = planar.front(0);
+    else
+      pareto = general.front(0);
+    frontier_type frontier{pareto.size(), n, m};
+    for (size_t i = 0; i < pareto.size(); ++i) {
+      const auto index = pareto[i];
+      copy_n(&parameters[n * index], n, frontier.parameters_iterator(i));
+      copy_n(&objectives[m * index], m, frontier.objectives_iterator(i));
+    }
+    return frontier;
+  }
+
+ private:
+  void insert(size_t index) {
+    const auto m = problem.objective_count();
+    if (m == 2)
+      planar.insert(objectives.data(), index);
+    else
+      general.insert(objectives.data(), m, index);
+  }
+
+  size_t remove() {
+    const auto m = problem.objective_count();
+    if (m == 2)
+      return planar.remove_least_contributor(objectives.data(), offset);
+    return general.remove_least_contributor(objectives.data(), m, offset);
+  }
+
+  problem_type problem{};
+
+  std::vector<real> parameters{};
+  std::vector<real> objectives{};
+  std::vector<real> scratch{};
+  planar_fronts<real> planar{};
+  general_fronts<real> general{};
+
+  /// Population Size
+  size_t s;
+  /// Slot that is used to store the next offspring.
+  size_t free;
+  /// Number of iterations given by initialization.
+  size_t iter;
+  /// Crossover/Mutation Ratio per Iteration
+  float crossover_probability;
+  /// Offset of the reference point with respect to the worst front's nadir.
+  real offset;
+};
+
+/// Short-hand function to set the parameters and optimize in one step. This
+/// function returns an instance to the SMS-EMOA optimizer.
+auto optimization(
+    problem auto problem,
+    generic::random_number_generator auto&& rng,
+    typename optimizer<decltype(problem)>::configuration config = {}) {
+  optimizer result(problem, rng, config);
+  result.optimize(std::forward<decltype(rng)>(rng));
+  return result;
+}
+
+/// Short-hand function overload to additionally make a frontier cast after
+/// optimization and discard the optimizer instance in one step.
+template <generic::frontier frontier_type>
+auto optimization(
+    problem auto problem,
+    generic::random_number_generator auto&& rng,
+    typename optimizer<decltype(problem)>::configuration config = {}) {
+  return frontier_cast<frontier_type>(
+      optimization(problem, std::forward<decltype(rng)>(rng), config));
+}
+
+}  // namespace sms_emoa
+
+}  // namespace lyrahgames::pareto
@@ -0,0 +1,60 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace lyrahgames::pareto {
+
+/// Bounded lock-free queue for exactly one producer thread and exactly one
+/// consumer thread. The capacity is rounded up to the next power of two.
+/// Producer and consumer positions live on separate cache lines to prevent
+/// false sharing. Neither 'try_push' nor 'try_pop' ever blocks.
+template <typename T>
+class spsc_queue {
+ public:
+  using value_type = T;
+
+  explicit spsc_queue(size_t capacity)
+      : buffer(std::bit_ceil(std::max<size_t>(1, capacity))),
+        mask(buffer.size() - 1) {}
+
+  spsc_queue(const spsc_queue&) = delete;
+  spsc_queue& operator=(const spsc_queue&) = delete;
+
+  /// Returns the maximum number of stored elements.
+  auto capacity() const noexcept { return buffer.size(); }
+
+  /// Moves the given value into the queue. Must only be called by the
+  /// producer. Returns false and leaves the value untouched if the queue is
+  /// full.
+  bool try_push(T& value) {
+    const auto t = tail.load(std::memory_order_relaxed);
+    if (t - head.load(std::memory_order_acquire) == buffer.size()) return false;
+    buffer[t & mask] = std::move(value);
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Moves the oldest element of the queue into the given value. Must only be
+  /// called by the consumer. Returns false if the queue is empty.
+  bool try_pop(T& value) {
+    const auto h = head.load(std::memory_order_relaxed);
+    if (h == tail.load(std::memory_order_acquire)) return false;
+    value = std::move(buffer[h & mask]);
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+ private:
+  std::vector<T> buffer;
+  size_t mask;
+  /// Position of the next element to pop, written by the consumer.
+  alignas(64) std::atomic<size_t> head{0};
+  /// Position of the next element to push, written by the producer.
+  alignas(64) std::atomic<size_t> tail{0};
+};
+
+}  // namespace lyrahgames::pareto
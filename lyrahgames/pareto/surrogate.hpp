@@ -0,0 +1,205 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <vector>
+//
+#include <lyrahgames/pareto/meta.hpp>
+
+namespace lyrahgames::pareto {
+
+/// Kriging surrogate with constant mean and Gaussian kernel that predicts the
+/// objectives of samples from a history of evaluated samples. Parameters are
+/// normalized to the unit cube given by the box of the problem. The kernel
+/// matrix of the history is stored as packed lower-triangular Cholesky factor
+/// whose rows are contiguous. Inserting a sample appends one row to the
+/// factor in O(N (n + N)) for N stored samples and 'n' parameters such that
+/// the model is fitted incrementally. All substitutions run along the rows of
+/// the factor. If the capacity is reached, the older half of the history is
+/// dropped and the factor is rebuilt.
+template <generic::real T>
+class surrogate {
+ public:
+  using real = T;
+
+  /// The length scale of the kernel is given in normalized coordinates. For
+  /// zero, it is set to the mean distance of uniformly distributed samples.
+  /// The nugget is added to the diagonal of the kernel matrix to keep it
+  /// positive definite for close samples.
+  struct configuration {
+    size_t capacity = 500;
+    real length_scale = 0;
+    real nugget = 1e-8;
+  };
+
+  surrogate() = default;
+  explicit surrogate(const generic::problem auto& problem,
+                     configuration config = {}) {
+    reset(problem, config);
+  }
+
+  /// Starts over with an empty history for the given problem.
+  void reset(const generic::problem auto& problem, configuration config = {}) {
+    using namespace std;
+    n = problem.parameter_count();
+    m = problem.objective_count();
+    lower.resize(n);
+    scale.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+      lower[i] = problem.box_min(i);
+      const auto width = problem.box_max(i) - problem.box_min(i);
+      scale[i] = (width > 0) ? 1 / width : real(1);
+    }
+    capacity = max<size_t>(config.capacity, 2);
+    const auto length =
+        (config.length_scale > 0) ? config.length_scale : sqrt(real(n) / 6);
+    theta = 1 / (2 * length * length);
+    nugget = config.nugget;
+    clear();
+  }
+
+  /// Removes all samples from the history.
+  void clear() {
+    x.clear();
+    y.clear();
+    factor.clear();
+    dirty = true;
+  }
+
+  /// Returns the number of samples in the history.
+  size_t sample_count() const noexcept { return n ? x.size() / n : 0; }
+
+  /// Adds an evaluated sample to the history. Samples that cannot be
+  /// distinguished from stored ones by the kernel are rejected and false is
+  /// returned.
+  bool insert(const real* parameters, const real* objectives) {
+    if (sample_count() == capacity) shrink();
+    point.resize(n);
+    for (size_t i = 0; i < n; ++i)
+      point[i] = (parameters[i] - lower[i]) * scale[i];
+    return append(point.data(), objectives);
+  }
+
+  /// Predicts the objectives of the given parameters. Without history, all
+  /// predictions are zero.
+  void predict(const real* parameters, real* objectives) {
+    fit();
+    point.resize(n);
+    for (size_t i = 0; i < n; ++i)
+      point[i] = (parameters[i] - lower[i]) * scale[i];
+    for (size_t j = 0; j < m; ++j)
+      objectives[j] = mean[j];
+    for (size_t k = 0; k < sample_count(); ++k) {
+      const auto c = kernel(point.data(), &x[n * k]);
+      for (size_t j = 0; j < m; ++j)
+        objectives[j] += c * weights[m * k + j];
+    }
+  }
+
+ private:
+  real kernel(const real* a, const real* b) const noexcept {
+    real d = 0;
+    for (size_t i = 0; i < n; ++i)
+      d += (a[i] - b[i]) * (a[i] - b[i]);
+    return std::exp(-theta * d);
+  }
+
+  /// Returns the first element of row 'k' of the packed factor.
+  real* row(size_t k) noexcept { return factor.data() + k * (k + 1) / 2; }
+
+  /// Appends a normalized sample by one step of the Cholesky decomposition.
+  bool append(const real* z, const real* objectives) {
+    using namespace std;
+    const auto count = sample_count();
+    // Forward substitution of the kernel vector with the current factor
+    column.resize(count + 1);
+    for (size_t k = 0; k < count; ++k) {
+      const auto l = row(k);
+      auto s = kernel(z, &x[n * k]);
+      for (size_t i = 0; i < k; ++i)
+        s -= l[i] * column[i];
+      column[k] = s / l[k];
+    }
+    // The remaining variance of a stored sample lies between one and two
+    // nuggets. Samples that do not exceed it are rejected as duplicates.
+    auto d = 1 + nugget;
+    for (size_t k = 0; k < count; ++k)
+      d -= column[k] * column[k];
+    if (!(d > 4 * nugget)) return false;
+    column[count] = sqrt(d);
+
+    factor.insert(factor.end(), column.begin(), column.end());
+    x.insert(x.end(), z, z + n);
+    y.insert(y.end(), objectives, objectives + m);
+    dirty = true;
+    return true;
+  }
+
+  /// Drops the older half of the history and rebuilds the factor.
+  void shrink() {
+    const auto count = sample_count();
+    const auto first = count - count / 2;
+    auto old_x = std::move(x);
+    auto old_y = std::move(y);
+    clear();
+    for (size_t k = first; k < count; ++k)
+      append(&old_x[n * k], &old_y[m * k]);
+  }
+
+  /// Solves the kernel system for the weights of all objectives at once if
+  /// samples have been added since the last fit.
+  void fit() {
+    if (!dirty) return;
+    const auto count = sample_count();
+    mean.assign(m, 0);
+    for (size_t k = 0; k < count; ++k)
+      for (size_t j = 0; j < m; ++j)
+        mean[j] += y[m * k + j] / count;
+    weights.resize(m * count);
+    for (size_t k = 0; k < count; ++k)
+      for (size_t j = 0; j < m; ++j)
+        weights[m * k + j] = y[m * k + j] - mean[j];
+
+    // Forward substitution with the factor
+    for (size_t k = 0; k < count; ++k) {
+      const auto l = row(k);
+      for (size_t i = 0; i < k; ++i)
+        for (size_t j = 0; j < m; ++j)
+          weights[m * k + j] -= l[i] * weights[m * i + j];
+      for (size_t j = 0; j < m; ++j)
+        weights[m * k + j] /= l[k];
+    }
+    // Backward substitution with the transposed factor along its rows
+    for (size_t k = count; k-- > 0;) {
+      const auto l = row(k);
+      for (size_t j = 0; j < m; ++j)
+        weights[m * k + j] /= l[k];
+      for (size_t i = 0; i < k; ++i)
+        for (size_t j = 0; j < m; ++j)
+          weights[m * i + j] -= l[i] * weights[m * k + j];
+    }
+    dirty = false;
+  }
+
+  size_t n = 0;
+  size_t m = 0;
+  size_t capacity = 0;
+  real theta = 1;
+  real nugget = 0;
+  /// Lower bounds and inverse widths of the box for normalization
+  std::vector<real> lower{};
+  std::vector<real> scale{};
+  /// Normalized parameters and objectives of the history
+  std::vector<real> x{};
+  std::vector<real> y{};
+  /// Packed rows of the Cholesky factor of the kernel matrix
+  std::vector<real> factor{};
+  /// Mean and weights of the kernels for every objective
+  std::vector<real> mean{};
+  std::vector<real> weights{};
+  bool dirty = true;
+  /// Scratch memory
+  std::vector<real> point{};
+  std::vector<real> column{};
+};
+
+}  // namespace lyrahgames::pareto
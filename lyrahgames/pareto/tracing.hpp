@@ -0,0 +1,339 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// Tracing scopes are only compiled in if 'LYRAHGAMES_PARETO_TRACING' is
+/// defined. Otherwise, they expand to nothing and have no overhead at all.
+#ifdef LYRAHGAMES_PARETO_TRACING
+#define LYRAHGAMES_PARETO_TRACE_CONCAT_IMPL(a, b) a##b
+#define LYRAHGAMES_PARETO_TRACE_CONCAT(a, b) \
+  LYRAHGAMES_PARETO_TRACE_CONCAT_IMPL(a, b)
+#define LYRAHGAMES_PARETO_TRACE_SCOPE(name)                          \
+  ::lyrahgames::pareto::tracing::scope LYRAHGAMES_PARETO_TRACE_CONCAT( \
+      lyrahgames_pareto_trace_, __LINE__)(name)
+#else
+#define LYRAHGAMES_PARETO_TRACE_SCOPE(name)
+#endif
+
+/// Number of events every thread keeps before overwriting its oldest ones.
+/// It has to be a power of two.
+#ifndef LYRAHGAMES_PARETO_TRACING_CAPACITY
+#define LYRAHGAMES_PARETO_TRACING_CAPACITY 65536
+#endif
+
+namespace lyrahgames::pareto::tracing {
+
+#ifdef LYRAHGAMES_PARETO_TRACING
+inline constexpr bool enabled = true;
+#else
+inline constexpr bool enabled = false;
+#endif
+
+using clock = std::chrono::steady_clock;
+
+/// Time of an event in nanoseconds since the start of the program
+using timestamp = uint64_t;
+
+inline const clock::time_point epoch = clock::now();
+
+inline timestamp to_timestamp(clock::time_point t) noexcept {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(t - epoch)
+      .count();
+}
+
+inline timestamp now() noexcept {
+  return to_timestamp(clock::now());
+}
+
+/// Recorded interval of time. The name has to be a string with static
+/// storage duration, like a string literal.
+struct event {
+  const char* name;
+  timestamp begin;
+  timestamp end;
+};
+
+/// Ring buffer of events written by exactly one thread at a time. Writing is
+/// lock-free and overwrites the oldest events when the buffer is full.
+class buffer {
+ public:
+  static constexpr size_t capacity = LYRAHGAMES_PARETO_TRACING_CAPACITY;
+  static_assert((capacity & (capacity - 1)) == 0,
+                "Tracing capacity has to be a power of two.");
+
+  explicit buffer(size_t track) : track(track) {}
+
+  void push(const event& e) noexcept {
+    const auto i = count.load(std::memory_order_relaxed);
+    events[i & (capacity - 1)] = e;
+    count.store(i + 1, std::memory_order_release);
+  }
+
+  /// Calls 'f(e)' for all events that are still stored, oldest first.
+  void for_each(auto&& f) const {
+    const auto last = count.load(std::memory_order_acquire);
+    const auto first = (last > capacity) ? (last - capacity) : 0;
+    for (auto i = first; i < last; ++i)
+      f(events[i & (capacity - 1)]);
+  }
+
+  void clear() noexcept { count.store(0, std::memory_order_relaxed); }
+
+  /// Index of the timeline the events are shown on
+  const size_t track;
+
+ private:
+  std::unique_ptr<event[]> events = std::make_unique<event[]>(capacity);
+  std::atomic<uint64_t> count{0};
+};
+
+/// Owner of all buffers. Threads acquire a buffer on their first event and
+/// hand it back when they exit. Because worker threads are started for every
+/// parallel evaluation, buffers are reused by later threads such that memory
+/// stays bounded. Every buffer is shown as its own track.
+class registry {
+ public:
+  buffer* acquire() {
+    std::scoped_lock lock{mutex};
+    if (!unused.empty()) {
+      const auto result = unused.back();
+      unused.pop_back();
+      return result;
+    }
+    buffers.push_back(std::make_unique<buffer>(buffers.size()));
+    return buffers.back().get();
+  }
+
+  void release(buffer* b) {
+    std::scoped_lock lock{mutex};
+    unused.push_back(b);
+  }
+
+  /// Calls 'f(buffer)' for every buffer. Events that are recorded
+  /// concurrently may or may not be seen.
+  void for_each(auto&& f) {
+    std::scoped_lock lock{mutex};
+    for (const auto& b : buffers)
+      f(*b);
+  }
+
+ private:
+  std::mutex mutex{};
+  std::vector<std::unique_ptr<buffer>> buffers{};
+  std::vector<buffer*> unused{};
+};
+
+inline registry& global_registry() {
+  static registry instance{};
+  return instance;
+}
+
+namespace detail {
+
+/// Hands the buffer of a thread back to the registry when the thread exits.
+struct thread_buffer {
+  buffer* pointer = nullptr;
+  ~thread_buffer() {
+    if (pointer) global_registry().release(pointer);
+  }
+};
+
+inline thread_local thread_buffer local{};
+
+}  // namespace detail
+
+/// Records an event on the track of the calling thread.
+inline void record(const char* name, timestamp begin, timestamp end) {
+  auto& b = detail::local.pointer;
+  if (!b) b = global_registry().acquire();
+  b->push({name, begin, end});
+}
+
+/// Records the lifetime of the scope as event. Use the macro
+/// 'LYRAHGAMES_PARETO_TRACE_SCOPE' to be able to compile it out.
+class scope {
+ public:
+  explicit scope(const char* name) noexcept : name(name), begin(now()) {}
+  ~scope() { record(name, begin, now()); }
+  scope(const scope&) = delete;
+  scope& operator=(const scope&) = delete;
+
+ private:
+  const char* name;
+  timestamp begin;
+};
+
+/// Discards all recorded events. No thread may record events concurrently.
+inline void clear() {
+  global_registry().for_each([](buffer& b) { b.clear(); });
+}
+
+namespace detail {
+
+inline void write_json_string(std::ostream& out, std::string_view str) {
+  out << '"';
+  for (auto c : str) {
+    if (c == '"' || c == '\\') out << '\\';
+    out << c;
+  }
+  out << '"';
+}
+
+inline void write_varint(std::string& out, uint64_t value) {
+  for (; value >= 0x80; value >>= 7)
+    out.push_back(char(value | 0x80));
+  out.push_back(char(value));
+}
+
+/// Protocol buffer fields with wire type 'varint'
+inline void write_field(std::string& out, uint32_t number, uint64_t value) {
+  write_varint(out, uint64_t{number} << 3);
+  write_varint(out, value);
+}
+
+/// Protocol buffer fields with wire type 'length-delimited' for strings and
+/// nested messages
+inline void write_field(std::string& out,
+                        uint32_t number,
+                        std::string_view bytes) {
+  write_varint(out, uint64_t{number} << 3 | 2);
+  write_varint(out, bytes.size());
+  out.append(bytes);
+}
+
+inline std::string track_name(size_t track) {
+  return "pareto " + std::to_string(track);
+}
+
+}  // namespace detail
+
+/// Writes all recorded events in the Chrome trace event format as JSON. The
+/// output can be opened by 'chrome://tracing' and 'ui.perfetto.dev'. No
+/// thread may record events concurrently.
+inline void write_chrome_trace(std::ostream& out) {
+  using namespace std;
+  const auto flags = out.flags();
+  const auto precision = out.precision();
+  out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  bool first = true;
+  const auto separate = [&] {
+    if (!first) out << ",\n";
+    first = false;
+  };
+  global_registry().for_each([&](const buffer& b) {
+    separate();
+    out << R"({"ph":"M","name":"thread_name","pid":1,"tid":)" << b.track
+        << R"(,"args":{"name":)";
+    detail::write_json_string(out, detail::track_name(b.track));
+    out << "}}";
+    b.for_each([&](const event& e) {
+      separate();
+      // Timestamps are given in microseconds.
+      out << R"({"ph":"X","pid":1,"tid":)" << b.track << ",\"ts\":" << fixed
+          << setprecision(3) << double(e.begin) * 1e-3
+          << ",\"dur\":" << double(e.end - e.begin) * 1e-3 << ",\"name\":";
+      detail::write_json_string(out, e.name);
+      out << '}';
+    });
+  });
+  out << "]}\n";
+  out.flags(flags);
+  out.precision(precision);
+}
+
+/// Writes all recorded events as binary Perfetto trace in protocol buffer
+/// format that can be opened by 'ui.perfetto.dev'. Every track is described
+/// by a thread track descriptor and its events are written as nested slices.
+/// No thread may record events concurrently.
+inline void write_perfetto_trace(std::ostream& out) {
+  using namespace std;
+  using detail::write_field;
+
+  // Field numbers of the Perfetto trace format
+  constexpr uint32_t trace_packet = 1;
+  constexpr uint32_t packet_timestamp = 8;
+  constexpr uint32_t packet_sequence = 10;
+  constexpr uint32_t packet_track_event = 11;
+  constexpr uint32_t packet_track_descriptor = 60;
+  constexpr uint32_t descriptor_uuid = 1;
+  constexpr uint32_t descriptor_name = 2;
+  constexpr uint32_t descriptor_thread = 4;
+  constexpr uint32_t thread_pid = 1;
+  constexpr uint32_t thread_tid = 2;
+  constexpr uint32_t thread_name = 5;
+  constexpr uint32_t event_type = 9;
+  constexpr uint32_t event_track = 11;
+  constexpr uint32_t event_name = 23;
+  constexpr uint64_t slice_begin = 1;
+  constexpr uint64_t slice_end = 2;
+
+  string packet{};
+  string message{};
+  string nested{};
+  vector<event> events{};
+  vector<timestamp> open{};
+
+  const auto emit = [&] {
+    string framed{};
+    write_field(framed, trace_packet, packet);
+    out.write(framed.data(), framed.size());
+    packet.clear();
+  };
+
+  global_registry().for_each([&](const buffer& b) {
+    const auto uuid = uint64_t(b.track) + 1;
+    const auto name = detail::track_name(b.track);
+
+    nested.clear();
+    write_field(nested, thread_pid, 1);
+    write_field(nested, thread_tid, uuid);
+    write_field(nested, thread_name, name);
+    message.clear();
+    write_field(message, descriptor_uuid, uuid);
+    write_field(message, descriptor_name, name);
+    write_field(message, descriptor_thread, nested);
+    write_field(packet, packet_sequence, uuid);
+    write_field(packet, packet_track_descriptor, message);
+    emit();
+
+    // Events are stored by their end. Slices have to be opened in order and
+    // enclosing slices first.
+    events.clear();
+    b.for_each([&](const event& e) { events.push_back(e); });
+    ranges::sort(events, [](const auto& x, const auto& y) {
+      return (x.begin < y.begin) || (x.begin == y.begin && x.end > y.end);
+    });
+
+    const auto slice = [&](uint64_t type, timestamp t, const char* label) {
+      message.clear();
+      write_field(message, event_type, type);
+      write_field(message, event_track, uuid);
+      if (label) write_field(message, event_name, label);
+      write_field(packet, packet_timestamp, t);
+      write_field(packet, packet_sequence, uuid);
+      write_field(packet, packet_track_event, message);
+      emit();
+    };
+
+    open.clear();
+    for (const auto& e : events) {
+      for (; !open.empty() && open.back() <= e.begin; open.pop_back())
+        slice(slice_end, open.back(), nullptr);
+      slice(slice_begin, e.begin, e.name);
+      open.push_back(e.end);
+    }
+    for (; !open.empty(); open.pop_back())
+      slice(slice_end, open.back(), nullptr);
+  });
+}
+
+}  // namespace lyrahgames::pareto::tracing
@@ -0,0 +1,101 @@
+#pragma once
+#include <cmath>
+#include <random>
+#include <ranges>
+#include <utility>
+//
+#include <lyrahgames/pareto/meta.hpp>
+
+namespace lyrahgames::pareto {
+
+/// Crossover Scheme
+/// Simulated binary crossover of the parameters of two parents at the given
+/// indices into two offspring. All other parameters of the offspring are left
+/// untouched such that grouped and sparse variations only pay for the
+/// parameters they change. The offspring may alias the parents.
+template <generic::real real>
+void simulated_binary_crossover(const std::ranges::input_range auto& indices,
+                                const real* parent1,
+                                const real* parent2,
+                                real* offspring1,
+                                real* offspring2,
+                                generic::random_number_generator auto&& rng) {
+  using namespace std;
+
+  constexpr real distribution_index = 2;
+  constexpr auto distribution_index_coeff = 1 / (distribution_index + 1);
+
+  uniform_real_distribution<real> distribution{0, 1};
+
+  for (size_t i : indices) {
+    const auto random = distribution(rng);
+    const auto beta =
+        (random <= real(0.5))
+            ? (pow(2 * random, distribution_index_coeff))
+            : (pow(1 / (2 * (1 - random)), distribution_index_coeff));
+
+    const auto tmp1 =
+        real(0.5) * ((1 + beta) * parent1[i] + (1 - beta) * parent2[i]);
+    const auto tmp2 =
+        real(0.5) * ((1 - beta) * parent1[i] + (1 + beta) * parent2[i]);
+
+    offspring1[i] = tmp1;
+    offspring2[i] = tmp2;
+  }
+}
+
+/// Simulated binary crossover of all 'n' parameters of two parents into two
+/// offspring. The offspring may alias the parents.
+template <generic::real real>
+void simulated_binary_crossover(size_t n,
+                                const real* parent1,
+                                const real* parent2,
+                                real* offspring1,
+                                real* offspring2,
+                                generic::random_number_generator auto&& rng) {
+  simulated_binary_crossover(std::views::iota(size_t{0}, n), parent1, parent2,
+                             offspring1, offspring2,
+                             std::forward<decltype(rng)>(rng));
+}
+
+/// Mutation Scheme
+/// The parameters of the parent at the given indices are moved by a uniformly
+/// distributed random step whose maximum is given by a tenth of the problem's
+/// box size and stored in the offspring. All other parameters of the
+/// offspring are left untouched.
+template <generic::problem problem_type>
+void alternate_random_mutation(problem_type& problem,
+                               const std::ranges::input_range auto& indices,
+                               const typename problem_type::real* parent,
+                               typename problem_type::real* offspring,
+                               generic::random_number_generator auto&& rng) {
+  using namespace std;
+  using real = typename problem_type::real;
+
+  constexpr real stepsize = 0.1;
+
+  // Construct oracle for random numbers.
+  uniform_real_distribution<real> distribution{-1, 1};
+  const auto uniform = [&] { return distribution(rng); };
+
+  // For all given parameters of the parent, draw new parameters.
+  for (size_t k : indices) {
+    const auto random = uniform();
+    const auto a = problem.box_min(k);
+    const auto b = problem.box_max(k);
+    offspring[k] = parent[k] + random * stepsize * (b - a);
+  }
+}
+
+/// Mutation of all parameters of the parent
+template <generic::problem problem_type>
+void alternate_random_mutation(problem_type& problem,
+                               const typename problem_type::real* parent,
+                               typename problem_type::real* offspring,
+                               generic::random_number_generator auto&& rng) {
+  const auto n = problem.parameter_count();
+  alternate_random_mutation(problem, std::views::iota(size_t{0}, n), parent,
+                            offspring, std::forward<decltype(rng)>(rng));
+}
+
+}  // namespace lyrahgames::pareto
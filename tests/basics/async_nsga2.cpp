@@ -0,0 +1,46 @@
+#include <random>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/pareto/async_nsga2.hpp>
+#include <lyrahgames/pareto/frontier.hpp>
+#include <lyrahgames/pareto/frontier_cast.hpp>
+//
+#include <lyrahgames/pareto/gallery/zitzler_deb_thiele.hpp>
+//
+#include "problems.hpp"
+
+using namespace std;
+using namespace lyrahgames::pareto;
+using namespace lyrahgames::pareto::testing;
+
+namespace {
+
+using real = double;
+using problem_type =
+    counting_problem<gallery::zitzler_deb_thiele_1_problem<real>>;
+
+}  // namespace
+
+TEST_CASE("Asynchronous NSGA2 evaluates exactly its budget") {
+  for (size_t threads : {1, 4}) {
+    mt19937 rng{1701};
+    problem_type problem{};
+    constexpr size_t population = 60;
+    constexpr size_t iterations = 5000;
+    async_nsga2::optimizer optimizer{problem, rng,
+                                     {.iterations = iterations,
+                                      .population = population,
+                                      .threads = threads}};
+    CHECK(*problem.evaluations == population);
+
+    optimizer.optimize(rng);
+    CHECK(*problem.evaluations == population + iterations);
+    optimizer.optimize(rng, 100);
+    CHECK(*problem.evaluations == population + iterations + 100);
+
+    const auto front = frontier_cast<frontier<real>>(optimizer);
+    CHECK(0 < front.sample_count());
+    CHECK(front.sample_count() <= population);
+  }
+}
@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <span>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/pareto/meta.hpp>
+//
+#include <lyrahgames/pareto/gallery/dtlz.hpp>
+#include <lyrahgames/pareto/gallery/zitzler_deb_thiele.hpp>
+
+using namespace std;
+using namespace lyrahgames::pareto;
+using namespace gallery;
+
+namespace {
+
+using real = double;
+
+/// Starts from a random parent and changes a random subset of its parameters
+/// in every step. The objectives are updated by 'evaluate_delta' from the
+/// previous ones and compared to a full evaluation. Hence, rounding errors of
+/// the chained updates are checked as well.
+template <generic::delta_evaluatable_problem problem_type>
+void check_delta_evaluation(problem_type problem, auto& rng) {
+  const auto n = problem.parameter_count();
+  const auto m = problem.objective_count();
+  uniform_real_distribution<real> distribution{0, 1};
+  const auto random = [&](size_t i) {
+    return lerp(problem.box_min(i), problem.box_max(i), distribution(rng));
+  };
+
+  vector<real> parent_x(n);
+  vector<real> parent_y(m);
+  for (size_t i = 0; i < n; ++i)
+    parent_x[i] = random(i);
+  problem.evaluate(span{parent_x}, span{parent_y});
+
+  vector<real> x(n);
+  vector<real> y(m);
+  vector<real> expected(m);
+  vector<size_t> indices(n);
+  vector<size_t> changed{};
+  for (size_t step = 0; step < 50; ++step) {
+    // Choose a random non-empty subset of the parameters.
+    iota(indices.begin(), indices.end(), 0);
+    shuffle(indices.begin(), indices.end(), rng);
+    const auto count = uniform_int_distribution<size_t>{1, n}(rng);
+    changed.assign(indices.begin(), indices.begin() + count);
+    sort(changed.begin(), changed.end());
+
+    x = parent_x;
+    for (auto i : changed)
+      x[i] = random(i);
+    problem.evaluate_delta(span<const real>{parent_x},
+                           span<const real>{parent_y},
+                           span<const size_t>{changed}, span<const real>{x},
+                           span{y});
+    problem.evaluate(span{x}, span{expected});
+    for (size_t j = 0; j < m; ++j)
+      CHECK(y[j] == doctest::Approx(expected[j]).epsilon(1e-10));
+
+    swap(parent_x, x);
+    swap(parent_y, y);
+  }
+}
+
+}  // namespace
+
+TEST_CASE("Delta evaluation of ZDT problems equals full evaluation") {
+  mt19937 rng{4321};
+  for (size_t t = 0; t < 20; ++t) {
+    check_delta_evaluation(zitzler_deb_thiele_1_problem<real>{}, rng);
+    check_delta_evaluation(zitzler_deb_thiele_2_problem<real>{}, rng);
+    check_delta_evaluation(zitzler_deb_thiele_3_problem<real>{}, rng);
+    check_delta_evaluation(zitzler_deb_thiele_4_problem<real>{}, rng);
+    check_delta_evaluation(zitzler_deb_thiele_6_problem<real>{}, rng);
+  }
+}
+
+TEST_CASE("Delta evaluation of DTLZ problems equals full evaluation") {
+  mt19937 rng{8765};
+  for (size_t m : {2, 3, 5}) {
+    for (size_t t = 0; t < 20; ++t) {
+      check_delta_evaluation(dtlz1<real>{m}, rng);
+      check_delta_evaluation(dtlz2<real>{m}, rng);
+      check_delta_evaluation(dtlz3<real>{m}, rng);
+      check_delta_evaluation(dtlz4<real>{m}, rng);
+      check_delta_evaluation(dtlz5<real>{m}, rng);
+      check_delta_evaluation(dtlz6<real>{m}, rng);
+      check_delta_evaluation(dtlz7<real>{m}, rng);
+    }
+  }
+}
@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/pareto/frontier.hpp>
+#include <lyrahgames/pareto/meta.hpp>
+#include <lyrahgames/pareto/nsga2.hpp>
+
+using namespace std;
+using namespace lyrahgames::pareto;
+
+namespace {
+
+using real = double;
+
+/// Problem whose objectives are shifted by an offset that can be changed from
+/// outside. Copies share the offset and the record of evaluated parameters.
+struct moving_problem {
+  using real = double;
+
+  size_t parameter_count() const { return n; }
+  static constexpr size_t objective_count() { return 2; }
+
+  static constexpr real box_min(size_t) { return 0; }
+  static constexpr real box_max(size_t) { return 1; }
+
+  void evaluate(const generic::range<real> auto& x,
+                generic::range<real> auto&& y) {
+    state->evaluated.emplace_back(x.begin(), x.end());
+    real g = 0;
+    for (size_t i = 1; i < n; ++i)
+      g += x[i];
+    y[0] = x[0] + state->offset;
+    y[1] = 1 - x[0] + g + state->offset;
+  }
+
+  struct shared {
+    real offset = 0;
+    vector<vector<real>> evaluated{};
+  };
+  size_t n = 4;
+  shared_ptr<shared> state = make_shared<shared>();
+};
+
+}  // namespace
+
+TEST_CASE("Dynamic NSGA2 draws distinct sentinels") {
+  mt19937 rng{1111};
+  moving_problem problem{};
+  constexpr size_t population = 20;
+  constexpr size_t select = population / 2;
+  nsga2::optimizer optimizer{problem, rng,
+                             {.population = population, .sentinels = select}};
+
+  // All survivors are sentinels and every one of them is checked once.
+  for (size_t g = 0; g < 10; ++g) {
+    problem.state->evaluated.clear();
+    optimizer.optimize(rng, 1);
+    REQUIRE(problem.state->evaluated.size() >= select);
+    vector<vector<real>> sentinels(problem.state->evaluated.begin(),
+                                   problem.state->evaluated.begin() + select);
+    sort(sentinels.begin(), sentinels.end());
+    CHECK(adjacent_find(sentinels.begin(), sentinels.end()) ==
+          sentinels.end());
+  }
+  CHECK(optimizer.change_count() == 0);
+}
+
+TEST_CASE("Dynamic NSGA2 keeps survivors when the budget ends in a response") {
+  // The sentinel uses the last evaluation such that no survivor can be
+  // re-evaluated or only the best few of them are.
+  for (size_t budget : {21, 25}) {
+    mt19937 rng{2222};
+    moving_problem problem{.n = 1};
+    constexpr size_t population = 20;
+    nsga2::optimizer optimizer{problem, rng,
+                               {.population = population,
+                                .sentinels = 1,
+                                .budget = {.evaluations = budget}}};
+
+    problem.state->offset = 1;
+    optimizer.optimize(rng, 5);
+    CHECK(optimizer.change_count() == 1);
+    CHECK(optimizer.evaluation_count() == budget);
+
+    // Offspring without budget are discarded but all survivors remain with
+    // their stale objectives instead of being lost.
+    const auto snapshot = optimizer.population_cast<frontier<real>>();
+    REQUIRE(snapshot.sample_count() == population);
+    for (size_t i = 0; i < population / 2; ++i) {
+      CHECK(isfinite(snapshot.objectives(i)[0]));
+      CHECK(isfinite(snapshot.objectives(i)[1]));
+    }
+  }
+}
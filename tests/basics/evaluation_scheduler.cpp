@@ -0,0 +1,72 @@
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/pareto/evaluation_scheduler.hpp>
+
+using namespace std;
+using namespace lyrahgames::pareto;
+
+TEST_CASE("Evaluation scheduler visits every index exactly once") {
+  mt19937 rng{99};
+  constexpr size_t threads = 4;
+  constexpr size_t count = 2000;
+  evaluation_scheduler scheduler{{.threads = threads, .grain = 1e-3}};
+  REQUIRE(scheduler.thread_count() == threads);
+
+  for (bool predict : {false, true}) {
+    vector<double> predicted(count);
+    uniform_real_distribution<double> distribution{-1e-5, 1e-4};
+    for (auto& x : predicted)
+      x = distribution(rng);
+
+    // The first thread is slow such that the others have to steal its tasks.
+    vector<atomic<size_t>> visits(count);
+    vector<atomic<size_t>> work(threads);
+    vector<double> measured(count, -1);
+    scheduler.run(
+        count,
+        [&](size_t thread, size_t index) {
+          CHECK(thread < threads);
+          ++visits[index];
+          ++work[thread];
+          if (thread == 0) this_thread::sleep_for(chrono::microseconds{200});
+        },
+        predict ? span<const double>{predicted} : span<const double>{},
+        span{measured});
+
+    for (size_t i = 0; i < count; ++i) {
+      CHECK(visits[i].load() == 1);
+      CHECK(measured[i] >= 0);
+    }
+    size_t total = 0;
+    for (auto& w : work)
+      total += w;
+    CHECK(total == count);
+    CHECK(work[0].load() < count / threads);
+  }
+}
+
+TEST_CASE("Evaluation scheduler rethrows the first exception") {
+  evaluation_scheduler scheduler{{.threads = 4}};
+  atomic<size_t> calls{0};
+  CHECK_THROWS_AS(scheduler.run(1000,
+                                [&](size_t, size_t index) {
+                                  ++calls;
+                                  if (index == 10)
+                                    throw runtime_error("Evaluation failed.");
+                                }),
+                  runtime_error);
+  CHECK(calls.load() <= 1000);
+
+  // The scheduler can be used again afterwards.
+  calls = 0;
+  scheduler.run(1000, [&](size_t, size_t) { ++calls; });
+  CHECK(calls.load() == 1000);
+}
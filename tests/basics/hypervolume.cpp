@@ -0,0 +1,139 @@
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/pareto/frontier.hpp>
+#include <lyrahgames/pareto/hypervolume.hpp>
+
+using namespace std;
+using namespace lyrahgames::pareto;
+
+namespace {
+
+using real = double;
+
+/// Computes the hypervolume of the given points by the inclusion-exclusion
+/// principle over all their non-empty subsets. The point with index 'skip' is
+/// left out.
+real brute_force_hypervolume(const frontier<real>& points,
+                             const vector<real>& r,
+                             size_t skip = numeric_limits<size_t>::max()) {
+  const auto n = points.sample_count();
+  const auto m = points.objective_count();
+  real result = 0;
+  for (size_t subset = 1; subset < (size_t{1} << n); ++subset) {
+    if (skip < n && (subset & (size_t{1} << skip))) continue;
+    real volume = 1;
+    for (size_t j = 0; j < m; ++j) {
+      auto corner = -numeric_limits<real>::infinity();
+      for (size_t i = 0; i < n; ++i)
+        if (subset & (size_t{1} << i))
+          corner = max(corner, points.objectives(i)[j]);
+      volume *= max(r[j] - corner, real{0});
+    }
+    result += (popcount(subset) % 2) ? volume : -volume;
+  }
+  return result;
+}
+
+/// Generates 'n' points in the unit cube. If 'front' is set, the points are
+/// projected onto the unit sphere such that they are mutually non-dominated.
+frontier<real> random_points(size_t n, size_t m, bool front, auto& rng) {
+  uniform_real_distribution<real> distribution{0, 1};
+  frontier<real> points{n, 0, m};
+  for (size_t i = 0; i < n; ++i) {
+    auto y = points.objectives_iterator(i);
+    real norm = 0;
+    for (size_t j = 0; j < m; ++j) {
+      y[j] = distribution(rng);
+      norm += y[j] * y[j];
+    }
+    if (front)
+      for (size_t j = 0; j < m; ++j)
+        y[j] /= sqrt(norm);
+  }
+  return points;
+}
+
+}  // namespace
+
+TEST_CASE("Exact hypervolume equals the inclusion-exclusion principle") {
+  mt19937 rng{12345};
+  for (size_t m = 2; m <= 5; ++m) {
+    const vector<real> r(m, 1.1);
+    for (size_t t = 0; t < 50; ++t) {
+      const auto points = random_points(1 + t % 10, m, t % 2, rng);
+      const auto expected = brute_force_hypervolume(points, r);
+      CHECK(hypervolume(points, r, 1) == doctest::Approx(expected));
+      CHECK(hypervolume(points, r, 4) == doctest::Approx(expected));
+    }
+  }
+}
+
+TEST_CASE("Hypervolume contributions equal the loss of hypervolume") {
+  mt19937 rng{54321};
+  for (size_t m = 2; m <= 5; ++m) {
+    const vector<real> r(m, 1.1);
+    for (size_t t = 0; t < 50; ++t) {
+      const auto points = random_points(1 + t % 10, m, true, rng);
+      const auto contributions = hypervolume_contributions(points, r);
+      const auto volume = brute_force_hypervolume(points, r);
+      REQUIRE(contributions.size() == points.sample_count());
+      for (size_t i = 0; i < points.sample_count(); ++i)
+        CHECK(contributions[i] ==
+              doctest::Approx(volume - brute_force_hypervolume(points, r, i))
+                  .scale(volume));
+    }
+  }
+}
+
+TEST_CASE("Duplicated points do not contribute to the hypervolume") {
+  for (size_t m = 2; m <= 4; ++m) {
+    const vector<real> r(m, 1);
+    frontier<real> points{3, 0, m};
+    for (size_t j = 0; j < m; ++j) {
+      points.objectives_iterator(0)[j] = (j == 0) ? 0.2 : 0.5;
+      points.objectives_iterator(1)[j] = (j == 0) ? 0.2 : 0.5;
+      points.objectives_iterator(2)[j] = (j == 0) ? 0.5 : 0.2;
+    }
+    const auto contributions = hypervolume_contributions(points, r);
+    CHECK(contributions[0] == 0);
+    CHECK(contributions[1] == 0);
+    CHECK(contributions[2] > 0);
+  }
+}
+
+TEST_CASE("Monte-Carlo estimation of the hypervolume stays inside its error") {
+  mt19937 rng{2718};
+  for (size_t m = 2; m <= 5; ++m) {
+    const vector<real> r(m, 1.1);
+    const auto points = random_points(8, m, true, rng);
+    const auto exact = hypervolume(points, r, 1);
+
+    // About 95% of all estimations lie inside of twice the error.
+    constexpr size_t runs = 40;
+    size_t inside = 0;
+    for (size_t k = 0; k < runs; ++k) {
+      const auto estimate = estimate_hypervolume(points, r, rng, 20'000, 1);
+      CHECK(estimate.samples == 20'000);
+      CHECK(estimate.error > 0);
+      CHECK(abs(estimate.value - exact) <= 5 * estimate.error);
+      inside += (abs(estimate.value - exact) <= 2 * estimate.error);
+    }
+    CHECK(inside >= 34);
+
+    // The estimation does not depend on the number of threads.
+    const auto seed = rng();
+    mt19937 first{seed};
+    mt19937 second{seed};
+    const auto a = estimate_hypervolume(points, r, first, 100'000, 1);
+    const auto b = estimate_hypervolume(points, r, second, 100'000, 4);
+    CHECK(a.value == b.value);
+    CHECK(a.error == b.error);
+  }
+}
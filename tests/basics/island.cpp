@@ -0,0 +1,86 @@
+#include <cmath>
+#include <random>
+#include <span>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/pareto/frontier.hpp>
+#include <lyrahgames/pareto/frontier_cast.hpp>
+#include <lyrahgames/pareto/island.hpp>
+#include <lyrahgames/pareto/nsga2.hpp>
+//
+#include <lyrahgames/pareto/gallery/zitzler_deb_thiele.hpp>
+//
+#include "problems.hpp"
+
+using namespace std;
+using namespace lyrahgames::pareto;
+using namespace lyrahgames::pareto::testing;
+
+namespace {
+
+using real = double;
+using problem_type =
+    counting_problem<gallery::zitzler_deb_thiele_1_problem<real>>;
+
+}  // namespace
+
+TEST_CASE("Island migration keeps the population size of all islands") {
+  for (auto topology : {island::topology::ring, island::topology::complete}) {
+    mt19937 rng{4711};
+    problem_type problem{};
+    constexpr size_t islands = 4;
+    constexpr size_t population = 50;
+    constexpr size_t generations = 40;
+    island::optimizer optimizer{problem, rng,
+                                {.islands = islands,
+                                 .population = population,
+                                 .migration_interval = 5,
+                                 .migrants = 20,
+                                 .topology = topology}};
+    REQUIRE(optimizer.island_count() == islands);
+    CHECK(*problem.evaluations == islands * population);
+
+    // Every generation of every island refills exactly the killed part of its
+    // population. Immigrants replace survivors and do not add new points.
+    optimizer.optimize(rng, generations);
+    const auto select = size_t(floor(0.5 * population));
+    CHECK(*problem.evaluations ==
+          islands * (population + generations * (population - select)));
+    for (size_t i = 0; i < islands; ++i) {
+      const auto front = frontier_cast<frontier<real>>(optimizer.island(i));
+      CHECK(0 < front.sample_count());
+      CHECK(front.sample_count() <= population);
+    }
+  }
+}
+
+TEST_CASE("Immigrants replace survivors and join the Pareto front") {
+  mt19937 rng{815};
+  gallery::zitzler_deb_thiele_1_problem<real> problem{};
+  const auto n = problem.parameter_count();
+  const auto m = problem.objective_count();
+  constexpr size_t population = 40;
+  nsga2::optimizer optimizer{problem, rng, {.population = population}};
+
+  // Pareto-optimal points cannot be dominated by any other point.
+  constexpr size_t count = 30;
+  vector<real> x(n * count);
+  vector<real> y(m * count);
+  for (size_t i = 0; i < count; ++i) {
+    const auto t = real(i) / (count - 1);
+    problem.pareto_optimal_parameters(t, span{&x[n * i], n});
+    problem.evaluate(span{&x[n * i], n}, span{&y[m * i], m});
+  }
+  optimizer.immigrate(count, x.data(), y.data());
+
+  // At most all surviving points are replaced.
+  const auto front = frontier_cast<frontier<real>>(optimizer);
+  CHECK(front.sample_count() <= population);
+  CHECK(front.sample_count() >= population / 2);
+  size_t found = 0;
+  for (size_t i = 0; i < front.sample_count(); ++i)
+    found += (front.parameters(i)[1] == 0);
+  CHECK(found == population / 2);
+}
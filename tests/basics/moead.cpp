@@ -0,0 +1,37 @@
+#include <random>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/pareto/frontier.hpp>
+#include <lyrahgames/pareto/hypervolume.hpp>
+#include <lyrahgames/pareto/moead.hpp>
+//
+#include <lyrahgames/pareto/gallery/zitzler_deb_thiele.hpp>
+
+using namespace std;
+using namespace lyrahgames::pareto;
+
+namespace {
+
+using real = double;
+
+}  // namespace
+
+TEST_CASE("MOEA/D approximates the Pareto front of ZDT1") {
+  // The exact Pareto front has a hypervolume of 1.21 - 1/3 = 0.877.
+  const vector<real> r{1.1, 1.1};
+  for (auto method : {moead::decomposition::tchebycheff,
+                      moead::decomposition::penalty_boundary_intersection}) {
+    mt19937 rng{2024};
+    const auto front = moead::optimization<frontier<real>>(
+        gallery::zitzler_deb_thiele_1_problem<real>{}, rng,
+        {.iterations = 400,
+         .population = 100,
+         .decomposition = method,
+         .threads = 1});
+    CHECK(front.sample_count() >= 80);
+    CHECK(front.sample_count() <= 100);
+    CHECK(hypervolume(front, r, 1) > 0.84);
+  }
+}
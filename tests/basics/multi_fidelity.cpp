@@ -0,0 +1,100 @@
+#include <random>
+#include <span>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/pareto/frontier.hpp>
+#include <lyrahgames/pareto/frontier_cast.hpp>
+#include <lyrahgames/pareto/meta.hpp>
+#include <lyrahgames/pareto/nsga2.hpp>
+//
+#include <lyrahgames/pareto/gallery/zitzler_deb_thiele.hpp>
+
+using namespace std;
+using namespace lyrahgames::pareto;
+
+namespace {
+
+using real = double;
+
+/// ZDT1 with a cheap lower level of fidelity whose objectives are shifted by
+/// a constant bias
+struct biased_problem : gallery::zitzler_deb_thiele_1_problem<real> {
+  static constexpr real shift = 0.25;
+
+  static constexpr size_t fidelity_count() { return 2; }
+
+  using zitzler_deb_thiele_1_problem::evaluate;
+
+  void evaluate(const generic::range<real> auto& x,
+                generic::range<real> auto&& y,
+                size_t level) {
+    evaluate(x, y);
+    if (level + 1 == fidelity_count()) return;
+    for (auto& v : y)
+      v += shift;
+  }
+};
+
+}  // namespace
+
+TEST_CASE("Multi-fidelity NSGA2 fully evaluates only promoted offspring") {
+  static_assert(generic::multi_fidelity_problem<biased_problem>);
+  mt19937 rng{7331};
+  constexpr size_t population = 40;
+  constexpr size_t select = population / 2;
+  nsga2::optimizer optimizer{biased_problem{}, rng,
+                             {.population = population}};
+
+  // The initial population calibrates the bias of the lower level.
+  CHECK(optimizer.evaluation_count() == population);
+  CHECK(optimizer.low_fidelity_evaluation_count() == population);
+
+  size_t filtered = 0;
+  for (size_t g = 0; g < 50; ++g) {
+    const auto evaluations = optimizer.evaluation_count();
+    const auto low = optimizer.low_fidelity_evaluation_count();
+    const auto hits = optimizer.cache_hit_count();
+    optimizer.optimize(rng, 1);
+    // All offspring that are not cached are filtered at the lower level.
+    const auto offspring =
+        population - select - (optimizer.cache_hit_count() - hits);
+    CHECK(optimizer.low_fidelity_evaluation_count() - low == offspring);
+    CHECK(optimizer.evaluation_count() - evaluations <= offspring);
+    filtered += offspring - (optimizer.evaluation_count() - evaluations);
+  }
+  CHECK(filtered > 0);
+
+  // The population never keeps objectives of the lower level.
+  biased_problem problem{};
+  const auto front = frontier_cast<frontier<real>>(optimizer);
+  REQUIRE(front.sample_count() > 0);
+  vector<real> y(2);
+  for (size_t i = 0; i < front.sample_count(); ++i) {
+    problem.evaluate(front.parameters(i), span{y});
+    CHECK(front.objectives(i)[0] == y[0]);
+    CHECK(front.objectives(i)[1] == y[1]);
+  }
+}
+
+TEST_CASE("Multi-fidelity NSGA2 updates promoted offspring by deltas") {
+  static_assert(generic::delta_evaluatable_problem<biased_problem>);
+  mt19937 rng{7332};
+  nsga2::optimizer optimizer{biased_problem{}, rng,
+                             {.population = 40, .groups = 6}};
+  optimizer.optimize(rng, 50);
+  CHECK(optimizer.delta_evaluation_count() > 0);
+  CHECK(optimizer.delta_evaluation_count() < optimizer.evaluation_count());
+
+  // Chained delta updates only deviate by rounding errors.
+  biased_problem problem{};
+  const auto front = frontier_cast<frontier<real>>(optimizer);
+  REQUIRE(front.sample_count() > 0);
+  vector<real> y(2);
+  for (size_t i = 0; i < front.sample_count(); ++i) {
+    problem.evaluate(front.parameters(i), span{y});
+    CHECK(front.objectives(i)[0] == doctest::Approx(y[0]).epsilon(1e-10));
+    CHECK(front.objectives(i)[1] == doctest::Approx(y[1]).epsilon(1e-10));
+  }
+}
@@ -0,0 +1,45 @@
+#include <random>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/pareto/frontier.hpp>
+#include <lyrahgames/pareto/hypervolume.hpp>
+#include <lyrahgames/pareto/nsga3.hpp>
+//
+#include <lyrahgames/pareto/gallery/zitzler_deb_thiele.hpp>
+
+using namespace std;
+using namespace lyrahgames::pareto;
+
+namespace {
+
+using real = double;
+
+}  // namespace
+
+TEST_CASE("NSGA-III approximates the Pareto front of ZDT1") {
+  // The exact Pareto front has a hypervolume of 1.21 - 1/3 = 0.877.
+  const vector<real> r{1.1, 1.1};
+  vector<frontier<real>> fronts{};
+  for (size_t threads : {1, 4}) {
+    mt19937 rng{2024};
+    const auto front = nsga3::optimization<frontier<real>>(
+        gallery::zitzler_deb_thiele_1_problem<real>{}, rng,
+        {.iterations = 500,
+         .population = 100,
+         .divisions = 99,
+         .threads = threads});
+    CHECK(front.sample_count() >= 40);
+    CHECK(front.sample_count() <= 100);
+    CHECK(hypervolume(front, r, 1) > 0.8);
+    fronts.push_back(front);
+  }
+
+  // The result does not depend on the number of threads.
+  REQUIRE(fronts[0].sample_count() == fronts[1].sample_count());
+  for (size_t i = 0; i < fronts[0].sample_count(); ++i) {
+    CHECK(fronts[0].objectives(i)[0] == fronts[1].objectives(i)[0]);
+    CHECK(fronts[0].objectives(i)[1] == fronts[1].objectives(i)[1]);
+  }
+}
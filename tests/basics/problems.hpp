@@ -0,0 +1,73 @@
+#pragma once
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+//
+#include <lyrahgames/pareto/meta.hpp>
+
+namespace lyrahgames::pareto::testing {
+
+/// Wraps a problem and counts its evaluations. Copies of the problem share
+/// the same thread-safe counter such that evaluations inside of optimizers
+/// can be observed from outside.
+template <generic::problem problem_type>
+struct counting_problem {
+  using real = typename problem_type::real;
+
+  size_t parameter_count() const { return problem.parameter_count(); }
+  size_t objective_count() const { return problem.objective_count(); }
+
+  real box_min(size_t index) const { return problem.box_min(index); }
+  real box_max(size_t index) const { return problem.box_max(index); }
+
+  void evaluate(const generic::range<real> auto& x,
+                generic::range<real> auto&& y) {
+    ++*evaluations;
+    problem.evaluate(x, y);
+  }
+
+  problem_type problem{};
+  std::shared_ptr<std::atomic<size_t>> evaluations =
+      std::make_shared<std::atomic<size_t>>(0);
+};
+
+/// Problem whose evaluation throws for samples with a large first parameter.
+struct throwing_problem {
+  using real = double;
+
+  static constexpr size_t parameter_count() { return 2; }
+  static constexpr size_t objective_count() { return 2; }
+
+  static constexpr real box_min(size_t) { return 0; }
+  static constexpr real box_max(size_t) { return 1; }
+
+  void evaluate(const generic::range<real> auto& x,
+                generic::range<real> auto&& y) {
+    if (x[0] > real(0.9))
+      throw std::runtime_error("Sample cannot be evaluated.");
+    y[0] = x[0];
+    y[1] = 1 - x[0] * x[1];
+  }
+};
+
+/// Returns 'count' uniformly distributed samples inside the parameter box of
+/// the given problem. The parameters of the samples are stored contiguously.
+template <generic::problem problem_type>
+auto random_samples(const problem_type& problem,
+                    size_t count,
+                    generic::random_number_generator auto&& rng) {
+  using real = typename problem_type::real;
+  const auto n = problem.parameter_count();
+  std::uniform_real_distribution<real> distribution{0, 1};
+  std::vector<real> x(n * count);
+  for (size_t i = 0; i < count; ++i)
+    for (size_t j = 0; j < n; ++j)
+      x[n * i + j] =
+          std::lerp(problem.box_min(j), problem.box_max(j), distribution(rng));
+  return x;
+}
+
+}  // namespace lyrahgames::pareto::testing
@@ -0,0 +1,72 @@
+#include <algorithm>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/pareto/meta.hpp>
+#include <lyrahgames/pareto/process_evaluator.hpp>
+//
+#include <lyrahgames/pareto/gallery/zitzler_deb_thiele.hpp>
+//
+#include "problems.hpp"
+
+using namespace std;
+using namespace lyrahgames::pareto;
+using namespace lyrahgames::pareto::testing;
+
+namespace {
+
+using real = double;
+
+}  // namespace
+
+TEST_CASE("Process evaluator evaluates like the local problem") {
+  mt19937 rng{1357};
+  gallery::zitzler_deb_thiele_1_problem<real> problem{};
+  const auto n = problem.parameter_count();
+  const auto m = problem.objective_count();
+
+  // The batch does not fit into the slots and has to be split into chunks.
+  constexpr size_t count = 1000;
+  const auto x = random_samples(problem, count, rng);
+  vector<real> expected(m * count);
+  for (size_t i = 0; i < count; ++i)
+    problem.evaluate(span{&x[n * i], n}, span{&expected[m * i], m});
+
+  process_evaluator evaluator{problem, {.processes = 3, .capacity = 64}};
+  CHECK(evaluator.process_count() == 3);
+  CHECK(evaluator.parameter_count() == n);
+  CHECK(evaluator.objective_count() == m);
+
+  vector<real> y(m * count);
+  evaluator.evaluate_batch(span<const real>{x}, span{y});
+  CHECK(y == expected);
+
+  // Single samples and copies of the evaluator use the same pool.
+  auto copy = evaluator;
+  vector<real> z(m);
+  copy.evaluate(span{&x[n * 7], n}, span{z});
+  CHECK(equal(z.begin(), z.end(), &expected[m * 7]));
+}
+
+TEST_CASE("Process evaluator reports exceptions of worker processes") {
+  mt19937 rng{2468};
+  throwing_problem problem{};
+  process_evaluator evaluator{problem, {.processes = 2, .capacity = 16}};
+
+  auto x = random_samples(problem, 100, rng);
+  vector<real> y(2 * 100);
+  x[2 * 42] = 1;
+  CHECK_THROWS_AS(evaluator.evaluate_batch(span<const real>{x}, span{y}),
+                  runtime_error);
+
+  // The pool can still be used after a failed evaluation.
+  x[2 * 42] = 0.5;
+  for (size_t i = 0; i < 100; ++i)
+    x[2 * i] = min(x[2 * i], real(0.9));
+  CHECK_NOTHROW(evaluator.evaluate_batch(span<const real>{x}, span{y}));
+  CHECK(y[2 * 42] == 0.5);
+}
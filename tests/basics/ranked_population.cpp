@@ -0,0 +1,100 @@
+#include <algorithm>
+#include <random>
+#include <ranges>
+#include <unordered_set>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/pareto/non_dominated_sort.hpp>
+#include <lyrahgames/pareto/ranked_population.hpp>
+
+using namespace std;
+using namespace lyrahgames::pareto;
+
+namespace {
+
+using real = double;
+
+/// Compares the layers of the population with a non-dominated sorting of all
+/// contained points from scratch.
+void check_layers(const ranked_population<real>& population,
+                  const vector<real>& y,
+                  size_t m) {
+  const auto slots = y.size() / m;
+  vector<size_t> indices{};
+  vector<real> points{};
+  for (size_t i = 0; i < slots; ++i) {
+    if (!population.contains(i)) continue;
+    indices.push_back(i);
+    points.insert(points.end(), &y[m * i], &y[m * (i + 1)]);
+  }
+  const auto count = indices.size();
+
+  vector<size_t> permutation{};
+  vector<size_t> fronts{};
+  unordered_set<size_t> pareto_indices{};
+  if (count > 0)
+    non_dominated_sort(points.data(), m, count, count, permutation, fronts,
+                       pareto_indices);
+  const auto front_count = (count > 0) ? fronts.size() - 1 : 0;
+  REQUIRE(population.front_count() == front_count);
+
+  const auto less = [&](size_t i, size_t j) {
+    return lexicographical_compare(&y[m * i], &y[m * (i + 1)], &y[m * j],
+                                   &y[m * (j + 1)]);
+  };
+  for (size_t k = 0; k < front_count; ++k) {
+    vector<size_t> expected{};
+    for (auto p = count - fronts[k + 1]; p < count - fronts[k]; ++p)
+      expected.push_back(indices[permutation[p]]);
+    auto front = population.front(k);
+    CHECK(is_sorted(front.begin(), front.end(), less));
+    for (auto i : front)
+      CHECK(population.rank(i) == k);
+    sort(expected.begin(), expected.end());
+    sort(front.begin(), front.end());
+    CHECK(front == expected);
+  }
+}
+
+}  // namespace
+
+TEST_CASE("Ranked population equals non-dominated sorting from scratch") {
+  mt19937 rng{1234};
+  for (size_t m = 2; m <= 4; ++m) {
+    constexpr size_t slots = 40;
+    vector<real> y(m * slots);
+    ranked_population<real> population{};
+    population.resize(slots);
+
+    // Objectives on a coarse grid additionally produce equal values and
+    // duplicated points.
+    uniform_int_distribution<int> grid{0, 7};
+    uniform_int_distribution<size_t> slot{0, slots - 1};
+    uniform_int_distribution<int> operation{0, 3};
+    for (size_t t = 0; t < 2000; ++t) {
+      const auto i = slot(rng);
+      switch (operation(rng)) {
+        case 0:
+        case 1:
+          if (population.contains(i)) population.remove(y.data(), m, i);
+          for (size_t j = 0; j < m; ++j)
+            y[m * i + j] = grid(rng);
+          population.insert(y.data(), m, i);
+          break;
+        case 2:
+          if (population.contains(i)) population.remove(y.data(), m, i);
+          break;
+        case 3:
+          if (population.front_count() == 0) break;
+          const auto last = population.front(population.front_count() - 1);
+          const auto index = population.remove_least_crowded(y.data(), m);
+          CHECK(ranges::find(last, index) != last.end());
+          CHECK(!population.contains(index));
+          break;
+      }
+      check_layers(population, y, m);
+    }
+  }
+}
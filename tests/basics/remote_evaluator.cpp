@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+//
+#include <unistd.h>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/pareto/meta.hpp>
+#include <lyrahgames/pareto/remote_evaluator.hpp>
+//
+#include <lyrahgames/pareto/gallery/zitzler_deb_thiele.hpp>
+//
+#include "problems.hpp"
+
+using namespace std;
+using namespace lyrahgames::pareto;
+using namespace lyrahgames::pareto::testing;
+
+namespace {
+
+using real = double;
+
+/// Returns a Unix socket address that is unique for the current process.
+string socket_address(const string& name) {
+  return "unix:/tmp/lyrahgames-pareto-" + name + "-" + to_string(getpid()) +
+         ".sock";
+}
+
+/// Runs a server for the given problem in the background until destruction.
+template <generic::problem problem_type>
+class background_server {
+ public:
+  background_server(problem_type problem, const string& address, size_t threads)
+      : server{problem, address, {.threads = threads}},
+        thread{[this] { server.serve(); }} {}
+
+  ~background_server() {
+    server.stop();
+    thread.join();
+    ::unlink(server.address().substr(5).c_str());
+  }
+
+  const auto& address() const { return server.address(); }
+
+ private:
+  remote_server<problem_type> server;
+  std::thread thread;
+};
+
+}  // namespace
+
+TEST_CASE("Remote evaluator evaluates like the local problem") {
+  mt19937 rng{1122};
+  gallery::zitzler_deb_thiele_1_problem<real> problem{};
+  const auto n = problem.parameter_count();
+  const auto m = problem.objective_count();
+
+  constexpr size_t count = 500;
+  const auto x = random_samples(problem, count, rng);
+  vector<real> expected(m * count);
+  for (size_t i = 0; i < count; ++i)
+    problem.evaluate(span{&x[n * i], n}, span{&expected[m * i], m});
+
+  for (size_t threads : {1, 4}) {
+    background_server server{problem, socket_address("round-trip"), threads};
+    remote_evaluator evaluator{problem, server.address(),
+                               {.batch = 16, .pipeline = 3}};
+
+    vector<real> y(m * count);
+    evaluator.evaluate_batch(span<const real>{x}, span{y});
+    CHECK(y == expected);
+
+    // Several submissions may be in flight before waiting for all of them.
+    y.assign(m * count, 0);
+    const auto half = count / 2;
+    evaluator.submit(span{x}.first(n * half), span{y}.first(m * half));
+    evaluator.submit(span{x}.subspan(n * half), span{y}.subspan(m * half));
+    evaluator.wait();
+    CHECK(y == expected);
+
+    vector<real> z(m);
+    evaluator.evaluate(span{&x[n * 3], n}, span{z});
+    CHECK(equal(z.begin(), z.end(), &expected[m * 3]));
+  }
+}
+
+TEST_CASE("Remote evaluator reports error frames of the server") {
+  mt19937 rng{3344};
+  throwing_problem problem{};
+  background_server server{problem, socket_address("error"), 2};
+  remote_evaluator evaluator{problem, server.address(),
+                             {.batch = 8, .pipeline = 2}};
+
+  auto x = random_samples(problem, 100, rng);
+  vector<real> y(2 * 100);
+  x[2 * 42] = 1;
+  CHECK_THROWS_AS(evaluator.evaluate_batch(span<const real>{x}, span{y}),
+                  runtime_error);
+
+  // The connection can still be used after an error.
+  for (size_t i = 0; i < 100; ++i)
+    x[2 * i] = min(x[2 * i], real(0.9));
+  CHECK_NOTHROW(evaluator.evaluate_batch(span<const real>{x}, span{y}));
+  CHECK(y[2 * 42] == x[2 * 42]);
+}
+
+TEST_CASE("Remote evaluator rejects requests not matching the problem") {
+  mt19937 rng{5566};
+  background_server server{gallery::zitzler_deb_thiele_1_problem<real>{},
+                           socket_address("width"), 1};
+
+  SUBCASE("parameter count") {
+    throwing_problem problem{};
+    remote_evaluator evaluator{problem, server.address()};
+    const auto x = random_samples(problem, 10, rng);
+    vector<real> y(2 * 10);
+    CHECK_THROWS_AS(evaluator.evaluate_batch(span<const real>{x}, span{y}),
+                    runtime_error);
+  }
+
+  SUBCASE("real type") {
+    gallery::zitzler_deb_thiele_1_problem<float> problem{};
+    remote_evaluator evaluator{problem, server.address()};
+    vector<float> x(problem.parameter_count() * 10, 0.5f);
+    vector<float> y(2 * 10);
+    CHECK_THROWS_AS(evaluator.evaluate_batch(span<const float>{x}, span{y}),
+                    runtime_error);
+  }
+}
@@ -0,0 +1,112 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/pareto/sampling.hpp>
+//
+#include <lyrahgames/pareto/gallery/zitzler_deb_thiele.hpp>
+
+using namespace std;
+using namespace lyrahgames::pareto;
+
+namespace {
+
+using real = double;
+
+/// Checks that every one of the 'count' equally sized strata of the unit
+/// interval contains exactly one of the given points in every dimension.
+void check_strata(const vector<real>& points, size_t count, size_t d) {
+  for (size_t j = 0; j < d; ++j) {
+    vector<size_t> hits(count, 0);
+    for (size_t i = 0; i < count; ++i) {
+      const auto x = points[d * i + j];
+      REQUIRE(0 <= x);
+      REQUIRE(x < 1);
+      ++hits[size_t(floor(x * count))];
+    }
+    CHECK(all_of(hits.begin(), hits.end(), [](auto h) { return h == 1; }));
+  }
+}
+
+}  // namespace
+
+TEST_CASE("Sobol sequence starts with the known points") {
+  // Unscrambled points of the first two dimensions
+  const vector<real> expected{0,     0,     0.5,   0.5,   0.75,  0.25,
+                              0.25,  0.75,  0.375, 0.375, 0.875, 0.875,
+                              0.625, 0.125, 0.125, 0.625};
+  sobol_sequence<real> sequence{2};
+  vector<real> points(expected.size());
+  sequence.generate(expected.size() / 2, points.data());
+  CHECK(points == expected);
+
+  // Every dimension of the first 2^k points is a (0, k, 1)-net.
+  constexpr size_t d = 20;
+  for (size_t k = 1; k <= 10; ++k) {
+    const size_t count = size_t{1} << k;
+    sobol_sequence<real> sequence{d};
+    vector<real> points(d * count);
+    sequence.generate(count, points.data());
+    check_strata(points, count, d);
+  }
+}
+
+TEST_CASE("Skipping ahead equals sequential generation") {
+  constexpr size_t d = 7;
+  constexpr size_t count = 300;
+  sobol_sequence<real> sobol{d};
+  halton_sequence<real> halton{d};
+  vector<real> sobol_points(d * count);
+  vector<real> halton_points(d * count);
+  sobol.generate(count, sobol_points.data());
+  halton.generate(count, halton_points.data());
+
+  for (size_t k : {0, 1, 2, 5, 64, 127, 128, 200, 299}) {
+    vector<real> x(d * (count - k));
+    sobol_sequence<real> sequence{d};
+    sequence.seek(k);
+    sequence.generate(count - k, x.data());
+    CHECK(equal(x.begin(), x.end(), sobol_points.begin() + d * k));
+
+    halton_sequence<real> other{d};
+    other.seek(k);
+    other.generate(count - k, x.data());
+    CHECK(equal(x.begin(), x.end(), halton_points.begin() + d * k));
+  }
+}
+
+TEST_CASE("Latin hypercube designs hit every stratum exactly once") {
+  mt19937 rng{31415};
+  vector<size_t> strata{};
+  for (size_t d : {1, 2, 5, 30}) {
+    for (size_t count : {1, 2, 10, 97, 500}) {
+      vector<real> points(d * count);
+      latin_hypercube(count, d, points.data(), rng, strata);
+      check_strata(points, count, d);
+    }
+  }
+}
+
+TEST_CASE("Samplers stay inside the parameter box") {
+  mt19937 rng{2718};
+  // The box of ZDT4 is not the unit cube.
+  gallery::zitzler_deb_thiele_4_problem<real> problem{};
+  const auto n = problem.parameter_count();
+  for (auto method : {sampling::uniform, sampling::sobol, sampling::halton,
+                      sampling::latin_hypercube}) {
+    sampler<real> samples{method, n, 17};
+    vector<real> x(n * 1000);
+    for (size_t t = 0; t < 3; ++t) {
+      samples.sample(problem, 1000, x.data(), rng);
+      size_t inside = 0;
+      for (size_t i = 0; i < 1000; ++i)
+        for (size_t j = 0; j < n; ++j)
+          inside += (problem.box_min(j) <= x[n * i + j]) &&
+                    (x[n * i + j] <= problem.box_max(j));
+      CHECK(inside == x.size());
+    }
+  }
+}
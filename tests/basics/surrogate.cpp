@@ -0,0 +1,95 @@
+#include <cmath>
+#include <random>
+#include <span>
+#include <vector>
+//
+#include <doctest/doctest.h>
+//
+#include <lyrahgames/pareto/nsga2.hpp>
+#include <lyrahgames/pareto/surrogate.hpp>
+//
+#include <lyrahgames/pareto/gallery/zitzler_deb_thiele.hpp>
+//
+#include "problems.hpp"
+
+using namespace std;
+using namespace lyrahgames::pareto;
+using namespace lyrahgames::pareto::testing;
+
+namespace {
+
+using real = double;
+
+}  // namespace
+
+TEST_CASE("Surrogate reproduces the objectives of its history") {
+  mt19937 rng{1618};
+  gallery::zitzler_deb_thiele_3_problem<real> problem{};
+  const auto n = problem.parameter_count();
+  const auto m = problem.objective_count();
+
+  constexpr size_t count = 100;
+  const auto x = random_samples(problem, count, rng);
+  vector<real> y(m * count);
+  for (size_t i = 0; i < count; ++i)
+    problem.evaluate(span{&x[n * i], n}, span{&y[m * i], m});
+
+  surrogate<real> model{problem};
+  for (size_t i = 0; i < count; ++i)
+    REQUIRE(model.insert(&x[n * i], &y[m * i]));
+  CHECK(model.sample_count() == count);
+
+  vector<real> prediction(m);
+  for (size_t i = 0; i < count; ++i) {
+    model.predict(&x[n * i], prediction.data());
+    for (size_t j = 0; j < m; ++j)
+      CHECK(prediction[j] == doctest::Approx(y[m * i + j]).epsilon(1e-5));
+  }
+
+  // Samples that are already stored are rejected.
+  CHECK_FALSE(model.insert(&x[n * 42], &y[m * 42]));
+  CHECK(model.sample_count() == count);
+}
+
+TEST_CASE("Surrogate drops the older half of its history at its capacity") {
+  mt19937 rng{2718};
+  gallery::zitzler_deb_thiele_1_problem<real> problem{};
+  const auto n = problem.parameter_count();
+  const auto m = problem.objective_count();
+
+  surrogate<real> model{problem, {.capacity = 64}};
+  const auto x = random_samples(problem, 200, rng);
+  vector<real> y(m * 200);
+  for (size_t i = 0; i < 200; ++i) {
+    problem.evaluate(span{&x[n * i], n}, span{&y[m * i], m});
+    model.insert(&x[n * i], &y[m * i]);
+    CHECK(model.sample_count() <= 64);
+  }
+
+  // The newest samples are still reproduced.
+  vector<real> prediction(m);
+  model.predict(&x[n * 199], prediction.data());
+  for (size_t j = 0; j < m; ++j)
+    CHECK(prediction[j] == doctest::Approx(y[m * 199 + j]).epsilon(1e-5));
+}
+
+TEST_CASE("Prescreened NSGA2 only evaluates the selected candidates") {
+  mt19937 rng{4242};
+  counting_problem<gallery::zitzler_deb_thiele_1_problem<real>> problem{};
+  constexpr size_t population = 40;
+  constexpr size_t select = population / 2;
+  nsga2::optimizer optimizer{problem, rng,
+                             {.population = population, .prescreening = 4}};
+  CHECK(*problem.evaluations == population);
+
+  for (size_t g = 0; g < 20; ++g) {
+    const size_t evaluations = *problem.evaluations;
+    const auto hits = optimizer.cache_hit_count();
+    optimizer.optimize(rng, 1);
+    // Offspring equal to their parents are taken from the cache.
+    CHECK(*problem.evaluations - evaluations +
+              optimizer.cache_hit_count() - hits ==
+          population - select);
+    CHECK(optimizer.evaluation_count() == *problem.evaluations);
+  }
+}